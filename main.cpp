@@ -11,6 +11,7 @@
 #include "src/ResourceManager.h"
 #include "src/SpriteBatch.h"
 #include "src/CameraSystem.h"
+#include "src/ThreadPool.h"
 
 #include "src/hex/HexGrid.h"
 #include "src/hex/HexMapData.h"
@@ -37,6 +38,7 @@ CameraController cameraController;
 // Game systems
 GameController *gameController = nullptr;
 AIController *aiController = nullptr;
+ThreadPool *aiPool = nullptr; // Parallel attack scoring on big maps
 InputHandler *inputHandler = nullptr;
 ReplaySystem *replaySystem = nullptr;
 
@@ -192,6 +194,7 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char **argv) {
 
     // Initialize game controller
     gameController = new GameController();
+    gameController->SetAsyncAI(true); // Keep frames flowing while the AI thinks
 
     // Initialize replay system
     replaySystem = new ReplaySystem();
@@ -234,7 +237,9 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char **argv) {
     gameController->InitializeGame(config);
 
     // Initialize AI controller
+    aiPool = new ThreadPool();
     aiController = new AIController(gameController);
+    aiController->SetEvaluationPool(aiPool);
     gameController->SetAIController(aiController);
 
     // Initialize hex map rendering
@@ -311,11 +316,15 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
     // Update game logic
     gameController->Update((float) appState.deltaTime);
 
-    // Playback mode: feed next action from replay when queue is empty
+    // Playback mode: feed replay actions when the queue is empty. Without a
+    // move delay, fill the whole queue so playback is not bound to frame rate.
     if (cmdArgs.playbackMode && replaySystem->HasNextAction()) {
-        if (!gameController->GetCombatQueue().HasPendingActions()) {
-            CombatAction action = replaySystem->GetNextAction();
-            gameController->GetCombatQueue().QueueAction(action);
+        CombatQueue &queue = gameController->GetCombatQueue();
+        if (!queue.HasPendingActions()) {
+            size_t batch = queue.GetProcessingDelay() <= 0.0f ? queue.GetFreeSlots() : 1;
+            for (size_t i = 0; i < batch && replaySystem->HasNextAction(); i++) {
+                queue.QueueAction(replaySystem->GetNextAction());
+            }
         }
     }
 
@@ -466,6 +475,7 @@ SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event) {
                 config.seed = MilSinceEpoch(); // New random seed
                 gameController->InitializeGame(config);
                 aiController = new AIController(gameController);
+                aiController->SetEvaluationPool(aiPool);
                 gameController->SetAIController(aiController);
                 const HexGrid &restartGrid = gameController->GetGrid();
                 const GameState &restartState = gameController->GetState();
@@ -492,6 +502,7 @@ void SDL_AppQuit(void *appstate, SDL_AppResult result) {
     delete uiManager;
     delete inputHandler;
     delete aiController;
+    delete aiPool;
     delete gameController;
     delete diceRenderer;
     delete hexMapRenderer;
@@ -0,0 +1,18 @@
+//
+// Profiling.h - Tracy zone macros for code that must also build without Tracy
+//
+
+#ifndef ATLAS_PROFILING_H
+#define ATLAS_PROFILING_H
+
+// The simulation core is shared between the game client (profiled with Tracy)
+// and headless tools that are built without the vendored Tracy sources.
+#if __has_include(<tracy/Tracy.hpp>)
+#include <tracy/Tracy.hpp>
+#else
+#define ZoneScoped
+#define ZoneScopedN(name)
+#define FrameMark
+#endif
+
+#endif // ATLAS_PROFILING_H
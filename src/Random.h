@@ -0,0 +1,94 @@
+//
+// Random.h - Small-state random engine shared by map generation, combat and AI
+//
+
+#ifndef ATLAS_RANDOM_H
+#define ATLAS_RANDOM_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+// xoshiro256** (Blackman & Vigna): 32 bytes of state, seeded through
+// SplitMix64. Meets UniformRandomBitGenerator, so it drops into the std
+// distributions and std::shuffle.
+class Xoshiro256StarStar
+{
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256StarStar(uint64_t seed = 1) { Seed(seed); }
+
+    void Seed(uint64_t seed)
+    {
+        for (uint64_t& word : _state)
+        {
+            seed += 0x9E3779B97F4A7C15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        const uint64_t result = std::rotl(_state[1] * 5, 7) * 9;
+        const uint64_t t = _state[1] << 17;
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= t;
+        _state[3] = std::rotl(_state[3], 45);
+        return result;
+    }
+
+    // Advance by 2^128 draws. Jumping copies of one engine 0, 1, 2... times
+    // gives parallel workers non-overlapping, reproducible streams.
+    void Jump()
+    {
+        static constexpr std::array<uint64_t, 4> JUMP = {
+            0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+        };
+
+        std::array<uint64_t, 4> jumped{};
+        for (uint64_t mask : JUMP)
+        {
+            for (int bit = 0; bit < 64; bit++)
+            {
+                if (mask & (uint64_t{1} << bit))
+                {
+                    for (int i = 0; i < 4; i++) jumped[i] ^= _state[i];
+                }
+                (*this)();
+            }
+        }
+        _state = jumped;
+    }
+
+private:
+    std::array<uint64_t, 4> _state{};
+};
+
+// Engine used by TerritoryGenerator, CombatSystem and the AI controllers.
+// Swap the alias to try another engine; everything goes through std distributions.
+using RandomEngine = Xoshiro256StarStar;
+
+// Engine seeded with `seed`, or from std::random_device when seed is 0
+inline RandomEngine MakeRandomEngine(unsigned int seed)
+{
+    if (seed == 0)
+    {
+        std::random_device rd;
+        return RandomEngine((static_cast<uint64_t>(rd()) << 32) | rd());
+    }
+    return RandomEngine(seed);
+}
+
+#endif // ATLAS_RANDOM_H
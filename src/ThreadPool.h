@@ -0,0 +1,55 @@
+//
+// ThreadPool.h - Fixed-size worker pool for CPU-bound jobs (AI search)
+//
+
+#ifndef ATLAS_THREADPOOL_H
+#define ATLAS_THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    // threadCount <= 0 uses one thread per hardware thread
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    [[nodiscard]] int GetThreadCount() const { return static_cast<int>(_workers.size()); }
+
+    // Queue a job; the future carries its result (or exception)
+    template<typename F>
+    auto Submit(F&& job) -> std::future<std::invoke_result_t<F>>
+    {
+        using Result = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(job));
+        std::future<Result> future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _jobs.emplace_back([task]() { (*task)(); });
+        }
+        _wake.notify_one();
+        return future;
+    }
+
+private:
+    std::vector<std::thread> _workers;
+    std::deque<std::function<void()>> _jobs;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    bool _stopping = false;
+
+    void WorkerLoop();
+};
+
+#endif // ATLAS_THREADPOOL_H
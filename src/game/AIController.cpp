@@ -4,28 +4,64 @@
 
 #include "AIController.h"
 #include "GameController.h"
+#include "DiceOdds.h"
 #include <algorithm>
-#include <queue>
-#include <unordered_set>
 
-#include <tracy/Tracy.hpp>
+#include "../Profiling.h"
 
 AIController::AIController(GameController* controller, unsigned int seed)
-    : _controller(controller),
-      _combat(&controller->GetCombatSystem())
+    : AIController(&controller->GetState(), seed)
 {
-    if (seed == 0)
-    {
-        std::random_device rd;
-        _rng = std::mt19937(rd());
-    }
-    else
+    _controller = controller;
+}
+
+AIController::AIController(const GameState* state, unsigned int seed)
+    : _state(state),
+      _rng(MakeRandomEngine(seed))
+{
+}
+
+bool AIController::TakeAction(PlayerId player)
+{
+    ZoneScoped;
+    if (!_controller) return false;
+
+    std::optional<CombatAction> action = DecideAction(_controller->GetState(), player);
+    if (!action)
     {
-        _rng = std::mt19937(seed);
+        return false;  // Done attacking
     }
+
+    // Execute the attack
+    GameState& state = _controller->GetState();
+    state.selectedTerritory = action->attackerId;
+    return _controller->Attack(action->defenderId);
 }
 
-bool AIController::TakeAction(PlayerId player)
+std::optional<CombatAction> AIController::DecideAction(const GameState& view, PlayerId player)
+{
+    ZoneScoped;
+    // Every helper reads *_state, so point it at the view for this decision
+    const GameState* bound = _state;
+    _state = &view;
+
+    const bool planned = _planner && player < MAX_PLAYERS &&
+                         (_planner->GetConfig().plannerPlayers & (1u << player));
+    std::optional<AttackEvaluation> chosen = planned ? NextPlannedAttack(player) : ChooseCachedAttack(player);
+
+    _state = bound;
+    if (!chosen) return std::nullopt;
+
+    CombatAction action;
+    action.attackerId = chosen->from;
+    action.defenderId = chosen->to;
+    action.attackerPlayer = player;
+    action.attackerDice = static_cast<uint8_t>(chosen->attackerDice);
+    action.defenderDice = static_cast<uint8_t>(chosen->defenderDice);
+    return action;
+}
+
+std::optional<AttackEvaluation> AIController::ChooseAttack(PlayerId player)
 {
     ZoneScoped;
     // Evaluate all possible attacks
@@ -33,7 +69,7 @@ bool AIController::TakeAction(PlayerId player)
 
     if (attacks.empty())
     {
-        return false;  // No attacks available
+        return std::nullopt;  // No attacks available
     }
 
     // Sort by score (highest first)
@@ -42,92 +78,594 @@ bool AIController::TakeAction(PlayerId player)
             return a.score > b.score;
         });
 
-    // Get the best attack
-    const AttackEvaluation& best = attacks[0];
+    return PickAttack(attacks[0], attacks.size() > 1 ? &attacks[1] : nullptr);
+}
 
+std::optional<AttackEvaluation> AIController::PickAttack(const AttackEvaluation& best,
+                                                         const AttackEvaluation* second)
+{
     // Check if it meets minimum thresholds
     if (best.winProbability < MIN_WIN_PROBABILITY ||
         best.score < MIN_ATTACK_SCORE)
     {
-        return false;  // Best attack isn't good enough
+        return std::nullopt;  // Best attack isn't good enough
     }
 
     // Add some randomness - occasionally pick second best if close
-    size_t choiceIdx = 0;
-    if (attacks.size() > 1 && attacks[1].score > best.score * 0.9f)
+    if (second && second->score > best.score * 0.9f)
     {
         if (std::uniform_real_distribution<float>(0.0f, 1.0f)(_rng) < 0.3f)
         {
-            choiceIdx = 1;
+            return *second;
         }
     }
 
-    const AttackEvaluation& chosen = attacks[choiceIdx];
+    return best;
+}
 
-    // Execute the attack
-    GameState& state = _controller->GetState();
-    state.selectedTerritory = chosen.from;
-    return _controller->Attack(chosen.to);
+std::optional<AttackEvaluation> AIController::ChooseCachedAttack(PlayerId player)
+{
+    ZoneScoped;
+    const GameState& state = *_state;
+    AttackCandidateCache& cache = _candidates;
+
+    if (cache.player != player || cache.turnNumber != state.turnNumber ||
+        cache.territoryCount != state.territories.size())
+    {
+        RebuildCandidateCache(player);
+    }
+    else
+    {
+        ApplyLastAttackToCache(player);
+    }
+
+    const CandidateHeapEntry* top = TopCandidate();
+    if (!top)
+    {
+        return std::nullopt;  // No attacks available
+    }
+
+    // Peek at the runner-up by lifting the best entry off the heap
+    const CandidateHeapEntry bestEntry = *top;
+    std::pop_heap(cache.heap.begin(), cache.heap.end());
+    cache.heap.pop_back();
+    const CandidateHeapEntry* runnerUp = TopCandidate();
+    std::optional<AttackEvaluation> second;
+    if (runnerUp) second = cache.candidates[runnerUp->slot];
+    cache.heap.push_back(bestEntry);
+    std::push_heap(cache.heap.begin(), cache.heap.end());
+
+    std::optional<AttackEvaluation> chosen =
+        PickAttack(cache.candidates[bestEntry.slot], second ? &*second : nullptr);
+    if (!chosen)
+    {
+        return std::nullopt;
+    }
+
+    cache.lastFrom = chosen->from;
+    cache.lastTo = chosen->to;
+    cache.lastDefender = state.GetOwner(chosen->to);
+    return chosen;
+}
+
+void AIController::RebuildCandidateCache(PlayerId player)
+{
+    ZoneScoped;
+    const GameState& state = *_state;
+    const TerritoryArrays& arrays = state.territoryArrays;
+    AttackCandidateCache& cache = _candidates;
+
+    cache.player = player;
+    cache.turnNumber = state.turnNumber;
+    cache.territoryCount = state.territories.size();
+    cache.candidates.clear();
+    cache.versions.clear();
+    cache.freeSlots.clear();
+    cache.slotByPair.clear();
+    cache.heap.clear();
+    cache.lastFrom = TERRITORY_NONE;
+    cache.lastTo = TERRITORY_NONE;
+    cache.lastDefender = PLAYER_NONE;
+
+    cache.largestRegionMember = FindLargestRegionMember(player);
+    cache.largestRegionSize = cache.largestRegionMember != TERRITORY_NONE
+                                  ? state.regions.RegionSize(cache.largestRegionMember)
+                                  : 0;
+
+    for (int p = 0; p < MAX_PLAYERS; p++)
+    {
+        cache.honorPenalty[p] = CalculateHonorPenalty(static_cast<PlayerId>(p), player);
+    }
+
+    std::vector<AttackEvaluation> evaluations;
+    for (size_t i = 0; i < arrays.Size(); i++)
+    {
+        if (arrays.owner[i] != player || arrays.diceCount[i] < 2) continue;
+
+        for (TerritoryId neighborId : state.GetNeighbors(static_cast<TerritoryId>(i)))
+        {
+            if (arrays.owner[neighborId] == player) continue;
+
+            AttackEvaluation eval;
+            eval.from = static_cast<TerritoryId>(i);
+            eval.to = neighborId;
+            evaluations.push_back(eval);
+        }
+    }
+
+    ForEachChunk(evaluations.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            evaluations[i] = EvaluateAttack(evaluations[i].from, evaluations[i].to, player,
+                                            cache.largestRegionMember);
+        }
+    });
+
+    for (const AttackEvaluation& eval : evaluations)
+    {
+        StoreCandidate(eval);
+    }
+}
+
+void AIController::ApplyLastAttackToCache(PlayerId player)
+{
+    ZoneScoped;
+    const GameState& state = *_state;
+    const TerritoryArrays& arrays = state.territoryArrays;
+    AttackCandidateCache& cache = _candidates;
+
+    if (cache.lastFrom == TERRITORY_NONE) return;
+
+    const TerritoryId from = cache.lastFrom;
+    const TerritoryId to = cache.lastTo;
+    const PlayerId defender = cache.lastDefender;
+    cache.lastFrom = TERRITORY_NONE;
+    cache.lastTo = TERRITORY_NONE;
+    cache.lastDefender = PLAYER_NONE;
+
+    // A score reads both territories and their neighbors, so any pair with an
+    // end within one step of a changed territory may have moved
+    std::vector<TerritoryId> nearby{from, to};
+    for (TerritoryId changed : {from, to})
+    {
+        for (TerritoryId neighborId : state.GetNeighbors(changed))
+        {
+            if (std::find(nearby.begin(), nearby.end(), neighborId) == nearby.end())
+            {
+                nearby.push_back(neighborId);
+            }
+        }
+    }
+    for (TerritoryId territory : nearby)
+    {
+        RefreshCandidatesAround(territory, player);
+    }
+
+    bool rescoreAll = false;
+
+    if (arrays.owner[to] == player)
+    {
+        // The capture merged regions: attacks from the merged region may now come
+        // from the largest one, and targets bordering it connect differently
+        std::vector<TerritoryId> region{to};
+        std::vector<uint8_t> inRegion(arrays.Size(), 0);
+        inRegion[to] = 1;
+        TerritoryId lowestMember = to;
+        bool containsLargest = false;
+        for (size_t head = 0; head < region.size(); head++)
+        {
+            TerritoryId current = region[head];
+            lowestMember = std::min(lowestMember, current);
+            containsLargest = containsLargest || current == cache.largestRegionMember;
+            for (TerritoryId neighborId : state.GetNeighbors(current))
+            {
+                if (arrays.owner[neighborId] == player && !inRegion[neighborId])
+                {
+                    inRegion[neighborId] = 1;
+                    region.push_back(neighborId);
+                }
+            }
+        }
+
+        int size = static_cast<int>(region.size());
+        if (size > cache.largestRegionSize ||
+            (size == cache.largestRegionSize && lowestMember < cache.largestRegionMember))
+        {
+            // A different region taking the lead demotes every attack from the old one
+            rescoreAll = !containsLargest;
+            cache.largestRegionSize = size;
+            cache.largestRegionMember = lowestMember;
+        }
+        else if (containsLargest)
+        {
+            cache.largestRegionSize = size;
+        }
+
+        if (!rescoreAll)
+        {
+            // Only the region-dependent parts of a score can have changed here:
+            // whether the attacker sits in the largest region, and how the
+            // target connects our regions. Rescore the pairs where either did.
+            const bool regionIsLargest =
+                state.regions.RegionOf(to) == state.regions.RegionOf(cache.largestRegionMember);
+            std::vector<uint8_t> targetSeen(arrays.Size(), 0);
+            for (TerritoryId member : region)
+            {
+                for (TerritoryId target : state.GetNeighbors(member))
+                {
+                    if (arrays.owner[target] == player) continue;
+
+                    if (!targetSeen[target])
+                    {
+                        targetSeen[target] = 1;
+                        int incomeGain = 0;
+                        bool connects = WouldConnectRegions(target, player, &incomeGain);
+                        for (TerritoryId attacker : state.GetNeighbors(target))
+                        {
+                            const AttackEvaluation* cached = FindCandidate(attacker, target);
+                            if (cached && (cached->wouldConnect != connects ||
+                                           cached->potentialIncomeGain != incomeGain))
+                            {
+                                RefreshCandidate(attacker, target, player);
+                            }
+                        }
+                    }
+
+                    const AttackEvaluation* cached = FindCandidate(member, target);
+                    if (cached && cached->fromLargestRegion != regionIsLargest)
+                    {
+                        RefreshCandidate(member, target, player);
+                    }
+                }
+            }
+        }
+    }
+
+    // Our first attack on a player in memory changes the honor penalty toward them
+    if (!rescoreAll && defender < MAX_PLAYERS)
+    {
+        float honor = CalculateHonorPenalty(defender, player);
+        if (honor != cache.honorPenalty[defender])
+        {
+            cache.honorPenalty[defender] = honor;
+            for (size_t slot = 0; slot < cache.candidates.size(); slot++)
+            {
+                const AttackEvaluation candidate = cache.candidates[slot];
+                if (candidate.from != TERRITORY_NONE && arrays.owner[candidate.to] == defender)
+                {
+                    RefreshCandidate(candidate.from, candidate.to, player);
+                }
+            }
+        }
+    }
+
+    if (rescoreAll)
+    {
+        RebuildCandidateCache(player);
+    }
+}
+
+void AIController::RefreshCandidate(TerritoryId from, TerritoryId to, PlayerId player)
+{
+    const TerritoryArrays& arrays = _state->territoryArrays;
+    AttackCandidateCache& cache = _candidates;
+
+    if (arrays.owner[from] != player || arrays.diceCount[from] < 2 || arrays.owner[to] == player)
+    {
+        auto it = cache.slotByPair.find((static_cast<uint32_t>(from) << 16) | to);
+        if (it != cache.slotByPair.end())
+        {
+            cache.candidates[it->second].from = TERRITORY_NONE;
+            cache.versions[it->second]++;
+            cache.freeSlots.push_back(it->second);
+            cache.slotByPair.erase(it);
+        }
+        return;
+    }
+
+    StoreCandidate(EvaluateAttack(from, to, player, cache.largestRegionMember));
+}
+
+AttackEvaluation AIController::EvaluateAttack(TerritoryId from, TerritoryId to, PlayerId player,
+                                              TerritoryId largestRegionMember)
+{
+    const GameState& state = *_state;
+    const TerritoryArrays& arrays = state.territoryArrays;
+
+    AttackEvaluation eval;
+    eval.from = from;
+    eval.to = to;
+    eval.attackerDice = arrays.diceCount[from];
+    eval.defenderDice = arrays.diceCount[to];
+    eval.winProbability = DiceOdds::WinProbability(eval.attackerDice, eval.defenderDice);
+
+    // Check if attacking from largest region
+    eval.fromLargestRegion = largestRegionMember != TERRITORY_NONE &&
+                             state.regions.RegionOf(from) == state.regions.RegionOf(largestRegionMember);
+
+    // Check if this would connect regions
+    int incomeGain = 0;
+    eval.wouldConnect = WouldConnectRegions(to, player, &incomeGain);
+    eval.potentialIncomeGain = incomeGain;
+
+    eval.score = ScoreAttack(eval, player, largestRegionMember != TERRITORY_NONE);
+    return eval;
+}
+
+TerritoryId AIController::FindLargestRegionMember(PlayerId player) const
+{
+    const GameState& state = *_state;
+    const TerritoryArrays& arrays = state.territoryArrays;
+
+    // Ties go to the region holding the lowest ID
+    TerritoryId largestMember = TERRITORY_NONE;
+    int largestSize = 0;
+    for (size_t i = 0; i < arrays.Size(); i++)
+    {
+        if (arrays.owner[i] != player) continue;
+
+        int size = state.regions.RegionSize(static_cast<TerritoryId>(i));
+        if (size > largestSize)
+        {
+            largestSize = size;
+            largestMember = static_cast<TerritoryId>(i);
+        }
+    }
+    return largestMember;
+}
+
+void AIController::StoreCandidate(const AttackEvaluation& eval)
+{
+    AttackCandidateCache& cache = _candidates;
+    const uint32_t key = (static_cast<uint32_t>(eval.from) << 16) | eval.to;
+
+    uint32_t slot;
+    auto it = cache.slotByPair.find(key);
+    if (it != cache.slotByPair.end())
+    {
+        slot = it->second;
+    }
+    else if (!cache.freeSlots.empty())
+    {
+        slot = cache.freeSlots.back();
+        cache.freeSlots.pop_back();
+        cache.slotByPair.emplace(key, slot);
+    }
+    else
+    {
+        slot = static_cast<uint32_t>(cache.candidates.size());
+        cache.candidates.emplace_back();
+        cache.versions.push_back(0);
+        cache.slotByPair.emplace(key, slot);
+    }
+
+    cache.candidates[slot] = eval;
+    cache.versions[slot]++;
+    cache.heap.push_back({eval.score, slot, cache.versions[slot]});
+    std::push_heap(cache.heap.begin(), cache.heap.end());
+}
+
+const AttackEvaluation* AIController::FindCandidate(TerritoryId from, TerritoryId to) const
+{
+    auto it = _candidates.slotByPair.find((static_cast<uint32_t>(from) << 16) | to);
+    return it != _candidates.slotByPair.end() ? &_candidates.candidates[it->second] : nullptr;
+}
+
+void AIController::RefreshCandidatesAround(TerritoryId territory, PlayerId player)
+{
+    for (TerritoryId neighborId : _state->GetNeighbors(territory))
+    {
+        RefreshCandidate(territory, neighborId, player);
+        RefreshCandidate(neighborId, territory, player);
+    }
+}
+
+const AIController::CandidateHeapEntry* AIController::TopCandidate()
+{
+    AttackCandidateCache& cache = _candidates;
+
+    // Drop the stale entries that rescoring left behind once they dominate the heap
+    if (cache.heap.size() > 4 * cache.slotByPair.size() + 64)
+    {
+        cache.heap.clear();
+        for (const auto& [key, slot] : cache.slotByPair)
+        {
+            cache.heap.push_back({cache.candidates[slot].score, slot, cache.versions[slot]});
+        }
+        std::make_heap(cache.heap.begin(), cache.heap.end());
+    }
+
+    while (!cache.heap.empty())
+    {
+        const CandidateHeapEntry& top = cache.heap.front();
+        if (cache.versions[top.slot] == top.version && cache.candidates[top.slot].from != TERRITORY_NONE)
+        {
+            return &top;
+        }
+        std::pop_heap(cache.heap.begin(), cache.heap.end());
+        cache.heap.pop_back();
+    }
+    return nullptr;
+}
+
+void AIController::SetEvaluationPool(ThreadPool* pool, size_t minParallelCandidates)
+{
+    _evaluationPool = pool;
+    _minParallelCandidates = std::max<size_t>(1, minParallelCandidates);
+}
+
+void AIController::ForEachChunk(size_t count, const std::function<void(size_t, size_t)>& work)
+{
+    if (!_evaluationPool || count < _minParallelCandidates)
+    {
+        work(0, count);
+        return;
+    }
+
+    ZoneScoped;
+    // One chunk per pool thread plus one for the calling thread, which works
+    // instead of idling on the futures
+    const size_t chunkCount = static_cast<size_t>(_evaluationPool->GetThreadCount()) + 1;
+    const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    std::vector<std::future<void>> pending;
+    pending.reserve(chunkCount);
+    for (size_t begin = chunkSize; begin < count; begin += chunkSize)
+    {
+        size_t end = std::min(count, begin + chunkSize);
+        pending.push_back(_evaluationPool->Submit([&work, begin, end]() { work(begin, end); }));
+    }
+    work(0, std::min(count, chunkSize));
+
+    for (auto& chunk : pending)
+    {
+        chunk.get();
+    }
+}
+
+void AIController::EnableTurnPlanner(const TurnPlannerConfig& config)
+{
+    _planner = std::make_unique<TurnPlanner>(config);
+    _plan.clear();
+    _planStep = 0;
+    _planPlayer = PLAYER_NONE;
+}
+
+std::optional<AttackEvaluation> AIController::NextPlannedAttack(PlayerId player)
+{
+    ZoneScoped;
+    const GameState& state = *_state;
+
+    // Plan once per turn, and again after a repelled attack (plans assume captures)
+    bool newTurn = player != _planPlayer || state.turnNumber != _planTurn;
+    bool repelled = _planStep > 0 && state.GetOwner(_plan[_planStep - 1].defenderId) != player;
+    if (newTurn || repelled)
+    {
+        _plan = _planner->PlanTurn(state, player);
+        _planStep = 0;
+        _planPlayer = player;
+        _planTurn = state.turnNumber;
+    }
+
+    if (_planStep >= _plan.size())
+    {
+        return std::nullopt;  // Plan finished
+    }
+
+    const CombatAction& action = _plan[_planStep++];
+    if (state.GetOwner(action.attackerId) != player || state.GetDice(action.attackerId) < 2 ||
+        state.GetOwner(action.defenderId) == player ||
+        !state.adjacency.AreAdjacent(action.attackerId, action.defenderId))
+    {
+        return std::nullopt;  // Stale plan
+    }
+
+    AttackEvaluation eval{};
+    eval.from = action.attackerId;
+    eval.to = action.defenderId;
+    eval.attackerDice = state.GetDice(action.attackerId);
+    eval.defenderDice = state.GetDice(action.defenderId);
+    eval.winProbability = DiceOdds::WinProbability(eval.attackerDice, eval.defenderDice);
+    eval.score = eval.winProbability;
+    return eval;
+}
+
+double AIController::EvaluatePosition(const GameState& state, PlayerId player)
+{
+    if (state.winner == player) return 1.0;
+
+    const PlayerAggregates& own = state.GetAggregates(player);
+    if (own.territories == 0) return 0.0;
+
+    const TerritoryArrays& arrays = state.territoryArrays;
+    const double territoryCount = static_cast<double>(arrays.Size());
+
+    int totalDice = 0;
+    for (int p = 0; p < state.config.playerCount; p++)
+    {
+        totalDice += state.playerAggregates[p].dice;
+    }
+
+    // End-of-turn reinforcements, capped by the room left on our territories
+    int capacity = own.territories * MAX_DICE_PER_TERRITORY - own.dice;
+    int reinforcements = std::min(state.GetReinforcements(player), capacity);
+
+    // Average chance that each of our territories falls to its strongest attacker
+    double threat = 0.0;
+    for (size_t i = 0; i < arrays.Size(); i++)
+    {
+        if (arrays.owner[i] != player || !arrays.isBorder[i]) continue;
+
+        float worst = 0.0f;
+        for (TerritoryId neighborId : state.GetNeighbors(static_cast<TerritoryId>(i)))
+        {
+            if (arrays.owner[neighborId] != player && arrays.diceCount[neighborId] >= 2)
+            {
+                worst = std::max(worst, DiceOdds::WinProbability(
+                    arrays.diceCount[neighborId], arrays.diceCount[i]));
+            }
+        }
+        threat += worst;
+    }
+    threat /= own.territories;
+
+    double value = 0.5 * state.regions.LargestRegion(player) / territoryCount +
+                   0.2 * own.territories / territoryCount +
+                   0.3 * (own.dice + reinforcements) / std::max(1, totalDice + reinforcements) -
+                   0.2 * threat;
+    return std::clamp(value, 0.0, 1.0);
 }
 
 std::vector<AttackEvaluation> AIController::EvaluateAttacks(PlayerId player)
 {
     ZoneScoped;
     std::vector<AttackEvaluation> evaluations;
-    const GameState& state = _controller->GetState();
+    const GameState& state = *_state;
+    const TerritoryArrays& arrays = state.territoryArrays;
 
-    // Pre-compute contiguous regions for strategic evaluation
-    std::vector<ContiguousRegion> regions = FindContiguousRegions(player);
-    const ContiguousRegion* largestRegion = FindLargestRegion(regions);
+    const TerritoryId largestRegionMember = FindLargestRegionMember(player);
 
-    for (const TerritoryData& territory : state.territories)
+    for (size_t i = 0; i < arrays.Size(); i++)
     {
         // Skip if not ours or can't attack
-        if (territory.owner != player || !territory.CanAttack())
+        if (arrays.owner[i] != player || arrays.diceCount[i] < 2)
         {
             continue;
         }
 
+        const TerritoryId territoryId = static_cast<TerritoryId>(i);
+
         // Check each neighbor
-        for (TerritoryId neighborId : territory.neighbors)
+        for (TerritoryId neighborId : state.GetNeighbors(territoryId))
         {
-            const TerritoryData* neighbor = state.GetTerritory(neighborId);
-            if (!neighbor || neighbor->owner == player)
+            if (arrays.owner[neighborId] == player)
             {
                 continue;
             }
 
             AttackEvaluation eval;
-            eval.from = territory.id;
+            eval.from = territoryId;
             eval.to = neighborId;
-            eval.attackerDice = territory.diceCount;
-            eval.defenderDice = neighbor->diceCount;
-            eval.winProbability = _combat->CalculateWinProbability(
-                eval.attackerDice, eval.defenderDice);
-
-            // Check if attacking from largest region
-            eval.fromLargestRegion = largestRegion && largestRegion->Contains(territory.id);
-
-            // Check if this would connect regions
-            int incomeGain = 0;
-            eval.wouldConnect = WouldConnectRegions(neighborId, player, regions, &incomeGain);
-            eval.potentialIncomeGain = incomeGain;
-
-            eval.score = ScoreAttack(eval, player, regions, largestRegion);
-
             evaluations.push_back(eval);
         }
     }
 
+    // Scoring only reads the state, so large candidate sets are split across the pool
+    ForEachChunk(evaluations.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            evaluations[i] = EvaluateAttack(evaluations[i].from, evaluations[i].to, player,
+                                            largestRegionMember);
+        }
+    });
+
     return evaluations;
 }
 
-float AIController::ScoreAttack(const AttackEvaluation& eval, PlayerId player,
-                               [[maybe_unused]] const std::vector<ContiguousRegion>& regions,
-                               const ContiguousRegion* largestRegion)
+float AIController::ScoreAttack(const AttackEvaluation& eval, PlayerId player, bool hasLargestRegion)
 {
     ZoneScoped;
-    const GameState& state = _controller->GetState();
+    const GameState& state = *_state;
     const TerritoryData* target = state.GetTerritory(eval.to);
     if (!target) return 0.0f;
 
@@ -176,7 +714,7 @@ float AIController::ScoreAttack(const AttackEvaluation& eval, PlayerId player,
 
     // Penalty for attacking from non-main region (unless it would connect)
     // Expanding isolated regions just spreads our dice thin without income benefit
-    if (!eval.fromLargestRegion && !eval.wouldConnect && largestRegion != nullptr)
+    if (!eval.fromLargestRegion && !eval.wouldConnect && hasLargestRegion)
     {
         score *= WEIGHT_NON_MAIN_REGION;
     }
@@ -216,150 +754,44 @@ float AIController::ScoreAttack(const AttackEvaluation& eval, PlayerId player,
     return score;
 }
 
-std::vector<ContiguousRegion> AIController::FindContiguousRegions(PlayerId player)
-{
-    ZoneScoped;
-    std::vector<ContiguousRegion> regions;
-    const GameState& state = _controller->GetState();
-
-    // Get all territories owned by player
-    std::unordered_set<TerritoryId> unvisited;
-    for (const auto& t : state.territories)
-    {
-        if (t.owner == player)
-        {
-            unvisited.insert(t.id);
-        }
-    }
-
-    // BFS from each unvisited territory to find connected regions
-    while (!unvisited.empty())
-    {
-        TerritoryId start = *unvisited.begin();
-        ContiguousRegion region;
-
-        std::queue<TerritoryId> queue;
-        queue.push(start);
-        unvisited.erase(start);
-
-        while (!queue.empty())
-        {
-            TerritoryId current = queue.front();
-            queue.pop();
-
-            const TerritoryData* t = state.GetTerritory(current);
-            if (!t) continue;
-
-            region.territories.insert(current);
-            region.totalDice += t->diceCount;
-
-            for (TerritoryId neighbor : t->neighbors)
-            {
-                if (unvisited.count(neighbor) > 0)
-                {
-                    const TerritoryData* nt = state.GetTerritory(neighbor);
-                    if (nt && nt->owner == player)
-                    {
-                        unvisited.erase(neighbor);
-                        queue.push(neighbor);
-                    }
-                }
-            }
-        }
-
-        regions.push_back(std::move(region));
-    }
-
-    return regions;
-}
-
-const ContiguousRegion* AIController::FindLargestRegion(const std::vector<ContiguousRegion>& regions)
+bool AIController::WouldConnectRegions(TerritoryId target, PlayerId player, int* outIncomeGain)
 {
-    if (regions.empty()) return nullptr;
-
-    const ContiguousRegion* largest = &regions[0];
-    for (const auto& region : regions)
+    const GameState& state = *_state;
+    const TerritoryArrays& arrays = state.territoryArrays;
+    auto neighbors = state.GetNeighbors(target);
+
+    // Sum the distinct regions of our territories around the target
+    int touchedCount = 0;
+    int totalSize = 1;  // The captured territory
+    int largestTouched = 0;
+    for (size_t i = 0; i < neighbors.size(); i++)
     {
-        if (region.Size() > largest->Size())
-        {
-            largest = &region;
-        }
-    }
-    return largest;
-}
-
-bool AIController::WouldConnectRegions(TerritoryId target, PlayerId player,
-                                       const std::vector<ContiguousRegion>& regions,
-                                       int* outIncomeGain)
-{
-    ZoneScoped;
-    const GameState& state = _controller->GetState();
-    const TerritoryData* territory = state.GetTerritory(target);
-    if (!territory) return false;
-
-    // Find which regions this territory touches
-    std::vector<const ContiguousRegion*> touchedRegions;
+        if (arrays.owner[neighbors[i]] != player) continue;
 
-    for (TerritoryId neighborId : territory->neighbors)
-    {
-        const TerritoryData* neighbor = state.GetTerritory(neighborId);
-        if (neighbor && neighbor->owner == player)
+        TerritoryId root = state.regions.RegionOf(neighbors[i]);
+        bool alreadyTouched = false;
+        for (size_t j = 0; j < i && !alreadyTouched; j++)
         {
-            // Find which region this neighbor belongs to
-            for (const auto& region : regions)
-            {
-                if (region.Contains(neighborId))
-                {
-                    // Check if we already have this region
-                    bool alreadyTouched = false;
-                    for (const auto* touched : touchedRegions)
-                    {
-                        if (touched == &region)
-                        {
-                            alreadyTouched = true;
-                            break;
-                        }
-                    }
-                    if (!alreadyTouched)
-                    {
-                        touchedRegions.push_back(&region);
-                    }
-                    break;
-                }
-            }
+            alreadyTouched = arrays.owner[neighbors[j]] == player &&
+                             state.regions.RegionOf(neighbors[j]) == root;
         }
-    }
+        if (alreadyTouched) continue;
 
-    // If we touch more than one region, capturing this would connect them
-    if (touchedRegions.size() > 1)
-    {
-        if (outIncomeGain)
-        {
-            // Calculate income gain: sum of all touched region sizes
-            // minus the size of the largest one (which we'd already get)
-            // plus 1 for the new territory
-            int totalSize = 1;  // The captured territory
-            int largestTouched = 0;
-            for (const auto* region : touchedRegions)
-            {
-                totalSize += region->Size();
-                largestTouched = std::max(largestTouched, region->Size());
-            }
-            // Before: income = largestTouched
-            // After: income = totalSize
-            *outIncomeGain = totalSize - largestTouched;
-        }
-        return true;
+        int size = state.regions.RegionSize(root);
+        touchedCount++;
+        totalSize += size;
+        largestTouched = std::max(largestTouched, size);
     }
 
-    if (outIncomeGain) *outIncomeGain = 0;
-    return false;
+    bool connects = touchedCount > 1;
+    if (outIncomeGain) *outIncomeGain = connects ? totalSize - largestTouched : 0;
+    return connects;
 }
 
 float AIController::CalculateExposureRisk(TerritoryId from, TerritoryId to, PlayerId player)
 {
     ZoneScoped;
-    const GameState& state = _controller->GetState();
+    const GameState& state = *_state;
     const TerritoryData* attacker = state.GetTerritory(from);
     const TerritoryData* target = state.GetTerritory(to);
     if (!attacker || !target) return 0.0f;
@@ -383,18 +815,19 @@ float AIController::CalculateExposureRisk(TerritoryId from, TerritoryId to, Play
     float capturedRisk = 0.0f;
 
     // Check enemies adjacent to target (excluding our attacker territory)
-    for (TerritoryId neighborId : target->neighbors)
+    for (TerritoryId neighborId : state.GetNeighbors(to))
     {
         if (neighborId == from) continue;  // Skip our attacking territory
 
-        const TerritoryData* neighbor = state.GetTerritory(neighborId);
-        if (neighbor && neighbor->owner != player && neighbor->owner != target->owner)
+        PlayerId neighborOwner = state.territoryArrays.owner[neighborId];
+        if (neighborOwner != player && neighborOwner != target->owner)
         {
             // This is a different enemy - strong enemies near target are dangerous
-            if (neighbor->diceCount >= diceAfterCapture + 2)
+            int neighborDice = state.territoryArrays.diceCount[neighborId];
+            if (neighborDice >= diceAfterCapture + 2)
             {
                 capturedRisk = std::max(capturedRisk,
-                    std::min(1.0f, (neighbor->diceCount - diceAfterCapture) / 6.0f));
+                    std::min(1.0f, (neighborDice - diceAfterCapture) / 6.0f));
             }
         }
     }
@@ -405,7 +838,7 @@ float AIController::CalculateExposureRisk(TerritoryId from, TerritoryId to, Play
 
 float AIController::CalculateRetributionScore(PlayerId defender, PlayerId attacker)
 {
-    const GameState& state = _controller->GetState();
+    const GameState& state = *_state;
 
     // Count how many times the defender has attacked us recently
     int attacksAgainstUs = state.attackHistory.CountAttacksFrom(
@@ -419,7 +852,7 @@ float AIController::CalculateRetributionScore(PlayerId defender, PlayerId attack
 
 float AIController::CalculateHonorPenalty(PlayerId defender, PlayerId attacker)
 {
-    const GameState& state = _controller->GetState();
+    const GameState& state = *_state;
 
     // Check if the defender has been peaceful toward us
     if (state.attackHistory.HasBeenPeaceful(defender, attacker, state.turnNumber))
@@ -441,53 +874,35 @@ float AIController::CalculateHonorPenalty(PlayerId defender, PlayerId attacker)
 
 int AIController::CountEnemyNeighbors(TerritoryId territory, PlayerId player)
 {
-    const GameState& state = _controller->GetState();
-    const TerritoryData* t = state.GetTerritory(territory);
-    if (!t) return 0;
-
+    const GameState& state = *_state;
     int count = 0;
-    for (TerritoryId neighborId : t->neighbors)
+    for (TerritoryId neighborId : state.GetNeighbors(territory))
     {
-        const TerritoryData* neighbor = state.GetTerritory(neighborId);
-        if (neighbor && neighbor->owner != player)
-        {
-            count++;
-        }
+        count += (state.territoryArrays.owner[neighborId] != player);
     }
     return count;
 }
 
 int AIController::CountFriendlyNeighbors(TerritoryId territory, PlayerId player)
 {
-    const GameState& state = _controller->GetState();
-    const TerritoryData* t = state.GetTerritory(territory);
-    if (!t) return 0;
-
+    const GameState& state = *_state;
     int count = 0;
-    for (TerritoryId neighborId : t->neighbors)
+    for (TerritoryId neighborId : state.GetNeighbors(territory))
     {
-        const TerritoryData* neighbor = state.GetTerritory(neighborId);
-        if (neighbor && neighbor->owner == player)
-        {
-            count++;
-        }
+        count += (state.territoryArrays.owner[neighborId] == player);
     }
     return count;
 }
 
 int AIController::GetStrongestAdjacentEnemy(TerritoryId territory, PlayerId player)
 {
-    const GameState& state = _controller->GetState();
-    const TerritoryData* t = state.GetTerritory(territory);
-    if (!t) return 0;
-
+    const GameState& state = *_state;
     int strongest = 0;
-    for (TerritoryId neighborId : t->neighbors)
+    for (TerritoryId neighborId : state.GetNeighbors(territory))
     {
-        const TerritoryData* neighbor = state.GetTerritory(neighborId);
-        if (neighbor && neighbor->owner != player)
+        if (state.territoryArrays.owner[neighborId] != player)
         {
-            strongest = std::max(strongest, static_cast<int>(neighbor->diceCount));
+            strongest = std::max(strongest, static_cast<int>(state.territoryArrays.diceCount[neighborId]));
         }
     }
     return strongest;
@@ -495,14 +910,13 @@ int AIController::GetStrongestAdjacentEnemy(TerritoryId territory, PlayerId play
 
 float AIController::EvaluateTerritoryValue(TerritoryId territory, PlayerId player)
 {
-    const GameState& state = _controller->GetState();
-    const TerritoryData* t = state.GetTerritory(territory);
-    if (!t) return 0.0f;
+    const GameState& state = *_state;
+    if (!state.GetTerritory(territory)) return 0.0f;
 
     float value = 0.0f;
 
     // More neighbors = more strategic value
-    value += t->neighbors.size() * 0.1f;
+    value += state.adjacency.Degree(territory) * 0.1f;
 
     // Fewer enemy neighbors = safer position after capture
     int enemyNeighbors = CountEnemyNeighbors(territory, player);
@@ -514,7 +928,7 @@ float AIController::EvaluateTerritoryValue(TerritoryId territory, PlayerId playe
     }
 
     // Territories with more hexes are slightly more valuable (larger visual presence)
-    value += t->hexes.size() * 0.02f;
+    value += state.territoryArrays.hexCount[territory] * 0.02f;
 
     return std::min(value, 1.0f);  // Cap at 1.0
 }
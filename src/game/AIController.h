@@ -6,22 +6,18 @@
 #define ATLAS_AICONTROLLER_H
 
 #include "GameData.h"
-#include "CombatSystem.h"
+#include "TurnPlanner.h"
+#include "../Random.h"
+#include "../ThreadPool.h"
+#include <functional>
+#include <memory>
+#include <optional>
 #include <random>
-#include <unordered_set>
+#include <unordered_map>
+#include <vector>
 
 class GameController;
 
-// Represents a contiguous region of territories owned by a player
-struct ContiguousRegion
-{
-    std::unordered_set<TerritoryId> territories;
-    int totalDice = 0;
-
-    [[nodiscard]] int Size() const { return static_cast<int>(territories.size()); }
-    [[nodiscard]] bool Contains(TerritoryId id) const { return territories.count(id) > 0; }
-};
-
 // Evaluation of a potential attack
 struct AttackEvaluation
 {
@@ -43,14 +39,46 @@ class AIController
 public:
     AIController(GameController* controller, unsigned int seed = 0);
 
+    // Evaluation-only controller reading an arbitrary state (e.g. a search copy).
+    // ChooseAttack works; TakeAction always passes.
+    AIController(const GameState* state, unsigned int seed = 0);
+
+    virtual ~AIController() = default;
+
     // Take a single action (attack or pass)
     // Returns true if an attack was made, false if done attacking
     bool TakeAction(PlayerId player);
 
-private:
-    GameController* _controller;
-    CombatSystem* _combat;
-    std::mt19937 _rng;
+    // Decide TakeAction's next attack from `view`, a copy of the game state
+    // (nullopt = end turn). Changes nothing but this controller, so it can run
+    // on a worker thread while the live state keeps rendering.
+    virtual std::optional<CombatAction> DecideAction(const GameState& view, PlayerId player);
+
+    // The attack TakeAction would make, without making it (nullopt = pass)
+    std::optional<AttackEvaluation> ChooseAttack(PlayerId player);
+
+    // Plan each turn with TurnPlanner and play the plan back instead of picking
+    // one greedy attack per call. A repelled attack triggers a replan.
+    void EnableTurnPlanner(const TurnPlannerConfig& config = {});
+    void DisableTurnPlanner() { _planner.reset(); }
+    [[nodiscard]] bool IsTurnPlannerEnabled() const { return _planner != nullptr; }
+
+    // Score attack candidates in parallel chunks on `pool` once a scan has at
+    // least `minParallelCandidates` of them (big maps). Null turns it off.
+    // The pool must not be one this controller's own calls run on.
+    void SetEvaluationPool(ThreadPool* pool, size_t minParallelCandidates = 256);
+
+    // Evaluate all possible attacks for player
+    std::vector<AttackEvaluation> EvaluateAttacks(PlayerId player);
+
+    // Static score of a player's position in [0, 1] after their end-of-turn
+    // reinforcements (largest region, territory and dice share, border threat)
+    [[nodiscard]] static double EvaluatePosition(const GameState& state, PlayerId player);
+
+protected:
+    GameController* _controller = nullptr;
+    const GameState* _state;
+    RandomEngine _rng;
 
     // Tuning parameters
     static constexpr float MIN_WIN_PROBABILITY = 0.40f;  // Don't attack if below this
@@ -64,24 +92,100 @@ private:
     static constexpr float WEIGHT_EXPOSURE_RISK = 0.3f;  // Penalty for exposing to strong enemies
     static constexpr float WEIGHT_NON_MAIN_REGION = 0.5f; // Penalty multiplier for attacking from non-main region
 
-    // Evaluate all possible attacks for player
-    std::vector<AttackEvaluation> EvaluateAttacks(PlayerId player);
+private:
+    ThreadPool* _evaluationPool = nullptr;
+    size_t _minParallelCandidates = 256;
 
-    // Score a potential attack
-    float ScoreAttack(const AttackEvaluation& eval, PlayerId player,
-                     const std::vector<ContiguousRegion>& regions,
-                     const ContiguousRegion* largestRegion);
+    // Run work(begin, end) over [0, count), split across the evaluation pool when large
+    void ForEachChunk(size_t count, const std::function<void(size_t, size_t)>& work);
+
+    // Turn planner state (null when planning is off)
+    std::unique_ptr<TurnPlanner> _planner;
+    std::vector<CombatAction> _plan;
+    size_t _planStep = 0;
+    PlayerId _planPlayer = PLAYER_NONE;
+    int _planTurn = 0;
 
-    // Find all contiguous regions for a player
-    std::vector<ContiguousRegion> FindContiguousRegions(PlayerId player);
+    // Next attack of the current turn plan, planning first if needed (nullopt = pass)
+    std::optional<AttackEvaluation> NextPlannedAttack(PlayerId player);
 
-    // Find the largest region (returns pointer to region in vector, or nullptr)
-    const ContiguousRegion* FindLargestRegion(const std::vector<ContiguousRegion>& regions);
+    // Attack candidates for the turn in progress. TakeAction keeps them across
+    // calls; after each combat only the pairs that combat could have affected
+    // are rescored, and a max-heap yields the best ones.
+    struct CandidateHeapEntry
+    {
+        float score = 0.0f;
+        uint32_t slot = 0;
+        uint32_t version = 0;
+
+        bool operator<(const CandidateHeapEntry& other) const { return score < other.score; }
+    };
+
+    struct AttackCandidateCache
+    {
+        PlayerId player = PLAYER_NONE;
+        int turnNumber = 0;
+        size_t territoryCount = 0;
+
+        std::vector<AttackEvaluation> candidates; // Slots; free ones have from == TERRITORY_NONE
+        std::vector<uint32_t> versions;           // Bumped whenever a slot changes
+        std::vector<uint32_t> freeSlots;
+        std::unordered_map<uint32_t, uint32_t> slotByPair; // (from << 16) | to -> slot
+        std::vector<CandidateHeapEntry> heap;     // Entries with stale versions are skipped
+
+        TerritoryId largestRegionMember = TERRITORY_NONE; // Lowest ID in the largest region
+        int largestRegionSize = 0;
+        std::array<float, MAX_PLAYERS> honorPenalty{};
+
+        // Attack handed out by the previous call, folded in on the next one
+        TerritoryId lastFrom = TERRITORY_NONE;
+        TerritoryId lastTo = TERRITORY_NONE;
+        PlayerId lastDefender = PLAYER_NONE;
+    };
+
+    AttackCandidateCache _candidates;
+
+    // ChooseAttack's thresholds and tie-breaking applied to the two best candidates
+    std::optional<AttackEvaluation> PickAttack(const AttackEvaluation& best, const AttackEvaluation* second);
+
+    // ChooseAttack backed by the candidate cache (same decision rules)
+    std::optional<AttackEvaluation> ChooseCachedAttack(PlayerId player);
+
+    void RebuildCandidateCache(PlayerId player);
+
+    // Rescore what the previous call's attack could have changed
+    void ApplyLastAttackToCache(PlayerId player);
+
+    // Insert, rescore or drop the (from, to) candidate to match the current state
+    void RefreshCandidate(TerritoryId from, TerritoryId to, PlayerId player);
+
+
+    // Insert or overwrite a candidate and push it on the heap
+    void StoreCandidate(const AttackEvaluation& eval);
+
+    // Cached candidate for the pair, or nullptr
+    [[nodiscard]] const AttackEvaluation* FindCandidate(TerritoryId from, TerritoryId to) const;
+
+    // RefreshCandidate for every pair with `territory` at either end
+    void RefreshCandidatesAround(TerritoryId territory, PlayerId player);
+
+    // Best live heap entry, discarding stale ones (nullptr if none)
+    const CandidateHeapEntry* TopCandidate();
+
+    // Evaluate and score one legal attack (read-only). The only per-pair scoring
+    // routine: EvaluateAttacks and the candidate cache both go through it.
+    AttackEvaluation EvaluateAttack(TerritoryId from, TerritoryId to, PlayerId player,
+                                    TerritoryId largestRegionMember);
+
+    // Lowest ID in the player's largest region (TERRITORY_NONE if they own nothing)
+    [[nodiscard]] TerritoryId FindLargestRegionMember(PlayerId player) const;
+
+    // Score a potential attack
+    float ScoreAttack(const AttackEvaluation& eval, PlayerId player, bool hasLargestRegion);
 
-    // Check if attack would connect separated regions and calculate income gain
-    bool WouldConnectRegions(TerritoryId target, PlayerId player,
-                            const std::vector<ContiguousRegion>& regions,
-                            int* outIncomeGain = nullptr);
+    // Check if capturing `target` would connect separated regions (compares the
+    // union-find roots of our neighbors) and calculate income gain
+    bool WouldConnectRegions(TerritoryId target, PlayerId player, int* outIncomeGain = nullptr);
 
     // Calculate exposure risk - how dangerous would our position be after attacking
     float CalculateExposureRisk(TerritoryId from, TerritoryId to, PlayerId player);
@@ -4,27 +4,35 @@
 
 #include "CombatQueue.h"
 
-void CombatQueue::QueueAction(const CombatAction& action) {
-    _pendingActions.push(action);
+static_assert((CombatQueue::CAPACITY & (CombatQueue::CAPACITY - 1)) == 0, "Ring indices wrap with a mask");
+
+bool CombatQueue::QueueAction(const CombatAction& action) {
+    if (_count == CAPACITY) {
+        return false;
+    }
+
+    _pendingActions[(_head + _count) & (CAPACITY - 1)] = action;
+    _count++;
 
     // If this is the first action, start the timer
-    if (_pendingActions.size() == 1) {
+    if (_count == 1) {
         _timer = _processingDelay;
         // If delay is 0, action is ready immediately
         _actionReady = (_processingDelay <= 0.0f);
     }
+    return true;
 }
 
 bool CombatQueue::HasPendingActions() const {
-    return !_pendingActions.empty();
+    return _count > 0;
 }
 
 bool CombatQueue::IsProcessing() const {
-    return !_pendingActions.empty();
+    return _count > 0;
 }
 
 void CombatQueue::Update(float deltaTime) {
-    if (_pendingActions.empty()) {
+    if (_count == 0) {
         _actionReady = false;
         return;
     }
@@ -36,15 +44,16 @@ void CombatQueue::Update(float deltaTime) {
 }
 
 std::optional<CombatAction> CombatQueue::PopNextAction() {
-    if (!_actionReady || _pendingActions.empty()) {
+    if (!_actionReady || _count == 0) {
         return std::nullopt;
     }
 
-    CombatAction action = _pendingActions.front();
-    _pendingActions.pop();
+    CombatAction action = _pendingActions[_head];
+    _head = (_head + 1) & (CAPACITY - 1);
+    _count--;
 
     // Reset timer for next action if queue still has items
-    if (!_pendingActions.empty()) {
+    if (_count > 0) {
         _timer = _processingDelay;
         // If delay is 0, next action is ready immediately
         _actionReady = (_processingDelay <= 0.0f);
@@ -64,13 +73,12 @@ float CombatQueue::GetProcessingDelay() const {
 }
 
 void CombatQueue::Clear() {
-    while (!_pendingActions.empty()) {
-        _pendingActions.pop();
-    }
+    _head = 0;
+    _count = 0;
     _timer = 0.0f;
     _actionReady = false;
 }
 
 size_t CombatQueue::GetQueueSize() const {
-    return _pendingActions.size();
+    return _count;
 }
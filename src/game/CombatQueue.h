@@ -6,15 +6,18 @@
 #define ATLAS_COMBATQUEUE_H
 
 #include "GameData.h"
-#include <queue>
+#include <array>
 #include <optional>
 
 class CombatQueue {
 public:
+    // Actions the queue can hold at once
+    static constexpr size_t CAPACITY = 256;
+
     CombatQueue() = default;
 
-    // Queue a new combat action
-    void QueueAction(const CombatAction& action);
+    // Queue a new combat action. Returns false (and drops it) if the queue is full.
+    bool QueueAction(const CombatAction& action);
 
     // Check if there are pending actions
     [[nodiscard]] bool HasPendingActions() const;
@@ -28,6 +31,21 @@ public:
     // Get the next action if ready (timer expired and queue non-empty)
     [[nodiscard]] std::optional<CombatAction> PopNextAction();
 
+    // Pop ready actions into process(action), at most maxActions of them, and
+    // return how many were processed. With a zero processing delay every
+    // queued action is ready; otherwise this pops at most one per elapsed delay.
+    template<typename Callback>
+    size_t DrainReady(Callback&& process, size_t maxActions = CAPACITY) {
+        size_t processed = 0;
+        while (processed < maxActions) {
+            std::optional<CombatAction> action = PopNextAction();
+            if (!action) break;
+            process(*action);
+            processed++;
+        }
+        return processed;
+    }
+
     // Configuration
     void SetProcessingDelay(float delay);
     [[nodiscard]] float GetProcessingDelay() const;
@@ -35,9 +53,13 @@ public:
     // Queue management
     void Clear();
     [[nodiscard]] size_t GetQueueSize() const;
+    [[nodiscard]] size_t GetFreeSlots() const { return CAPACITY - _count; }
 
 private:
-    std::queue<CombatAction> _pendingActions;
+    // Fixed ring buffer: _count actions starting at _head
+    std::array<CombatAction, CAPACITY> _pendingActions{};
+    size_t _head = 0;
+    size_t _count = 0;
     float _processingDelay = 0.0f;  // Delay between processing each action (0 = instant)
     float _timer = 0.0f;
     bool _actionReady = false;
@@ -3,37 +3,46 @@
 //
 
 #include "CombatSystem.h"
-#include <numeric>
+#include "DiceOdds.h"
+#include <algorithm>
 
-#include <tracy/Tracy.hpp>
+#include "../Profiling.h"
 
 CombatSystem::CombatSystem(unsigned int seed)
+    : _rng(MakeRandomEngine(seed))
 {
-    if (seed == 0)
-    {
-        std::random_device rd;
-        _rng = std::mt19937(rd());
-    }
-    else
-    {
-        _rng = std::mt19937(seed);
-    }
 }
 
-int CombatSystem::RollDie()
+int CombatSystem::RollSum(int count)
 {
-    return std::uniform_int_distribution<>(1, 6)(_rng);
+    count = std::clamp(count, 0, MAX_DICE_PER_TERRITORY);
+    return DiceOdds::SumFromBits(count, _rng());
 }
 
-std::vector<int> CombatSystem::RollDice(int count)
+void CombatSystem::RollDiceWithTotal(RandomEngine& rng, int count, int total, std::span<uint8_t> rolls)
 {
-    std::vector<int> rolls;
-    rolls.reserve(count);
-    for (int i = 0; i < count; i++)
+    if (count < 0 || count > static_cast<int>(rolls.size()) || total < 0 || total > DiceOdds::MAX_SUM ||
+        DiceOdds::SUM_WAYS[count][total] == 0)
+    {
+        return;  // No dice can make this total
+    }
+
+    for (int remaining = count; remaining > 0; remaining--)
     {
-        rolls.push_back(RollDie());
+        // Pick this die's face with weight = ways the other dice make up the rest
+        uint32_t draw = std::uniform_int_distribution<uint32_t>(
+            0, DiceOdds::SUM_WAYS[remaining][total] - 1)(rng);
+        int face = 1;
+        for (; face < 6; face++)
+        {
+            const int rest = total - face;
+            const uint32_t ways = rest >= 0 ? DiceOdds::SUM_WAYS[remaining - 1][rest] : 0;
+            if (draw < ways) break;
+            draw -= ways;
+        }
+        rolls[count - remaining] = static_cast<uint8_t>(face);
+        total -= face;
     }
-    return rolls;
 }
 
 CombatResult CombatSystem::ResolveCombat(
@@ -46,22 +55,13 @@ CombatResult CombatSystem::ResolveCombat(
     result.defenderId = defender.id;
     result.attackerPlayer = attacker.owner;
     result.defenderPlayer = defender.owner;
+    result.attackerDiceCount = static_cast<uint8_t>(std::clamp<int>(attacker.diceCount, 0, MAX_DICE_PER_TERRITORY));
+    result.defenderDiceCount = static_cast<uint8_t>(std::clamp<int>(defender.diceCount, 0, MAX_DICE_PER_TERRITORY));
 
-    // Roll dice for both sides
-    result.attackerRolls = RollDice(attacker.diceCount);
-    result.defenderRolls = RollDice(defender.diceCount);
-
-    // Calculate totals
-    result.attackerTotal = std::accumulate(
-        result.attackerRolls.begin(),
-        result.attackerRolls.end(),
-        0
-    );
-    result.defenderTotal = std::accumulate(
-        result.defenderRolls.begin(),
-        result.defenderRolls.end(),
-        0
-    );
+    // One draw per side on the dice sum distribution
+    result.attackerTotal = RollSum(result.attackerDiceCount);
+    result.defenderTotal = RollSum(result.defenderDiceCount);
+    result.rollSeed = _rng();
 
     // Attacker wins on higher total (ties go to attacker in this variant)
     result.attackerWins = result.attackerTotal > result.defenderTotal;
@@ -69,62 +69,37 @@ CombatResult CombatSystem::ResolveCombat(
     return result;
 }
 
+void CombatSystem::RevealRolls(CombatResult& result)
+{
+    if (result.rollsRevealed) return;
+
+    RandomEngine rng(result.rollSeed);
+    RollDiceWithTotal(rng, result.attackerDiceCount, result.attackerTotal, result.attackerRolls);
+    RollDiceWithTotal(rng, result.defenderDiceCount, result.defenderTotal, result.defenderRolls);
+    result.rollsRevealed = true;
+}
+
 void CombatSystem::ApplyCombatResult(GameState& state, const CombatResult& result)
 {
-    TerritoryData* attacker = state.GetTerritory(result.attackerId);
-    TerritoryData* defender = state.GetTerritory(result.defenderId);
+    if (!state.GetTerritory(result.attackerId) || !state.GetTerritory(result.defenderId)) return;
 
-    if (!attacker || !defender) return;
+    // The real game plays by the same make/unmake rules as look-ahead search
+    CombatAction action;
+    action.attackerId = result.attackerId;
+    action.defenderId = result.defenderId;
+    action.attackerPlayer = result.attackerPlayer;
+    action.attackerDice = result.attackerDiceCount;
+    action.defenderDice = result.defenderDiceCount;
+    state.ApplyAction(action, result.attackerWins);
 
     if (result.attackerWins)
     {
-        // Attacker captures defender's territory
-        // Move all but one die to captured territory
-        int movingDice = attacker->diceCount - 1;
-
-        defender->owner = result.attackerPlayer;
-        defender->diceCount = static_cast<uint8_t>(movingDice);
-        attacker->diceCount = 1;
-
         // Territory ownership changed - map needs refresh
         state.mapNeedsRefresh = true;
     }
-    else
-    {
-        // Defender wins - attacker loses all but one die
-        attacker->diceCount = 1;
-    }
 }
 
 float CombatSystem::CalculateWinProbability(int attackerDice, int defenderDice) const
 {
-    // Approximate win probability using expected values and standard deviation
-    // Mean for n dice: n * 3.5
-    // Variance for n dice: n * (35/12) ≈ 2.917
-    // Standard deviation: sqrt(n * 2.917)
-
-    if (attackerDice <= 0 || defenderDice <= 0) return 0.0f;
-
-    float attackerMean = attackerDice * 3.5f;
-    float defenderMean = defenderDice * 3.5f;
-
-    float attackerVar = attackerDice * 2.917f;
-    float defenderVar = defenderDice * 2.917f;
-
-    // Combined variance of difference
-    float diffVar = attackerVar + defenderVar;
-    float diffStd = std::sqrt(diffVar);
-
-    // Difference in means
-    float diffMean = attackerMean - defenderMean;
-
-    // Approximate probability using normal distribution
-    // P(attacker > defender) ≈ P(Z > -diffMean/diffStd)
-    // Using error function approximation
-    float z = diffMean / diffStd;
-
-    // Approximate CDF using logistic function (good approximation to normal CDF)
-    float prob = 1.0f / (1.0f + std::exp(-1.7f * z));
-
-    return prob;
+    return DiceOdds::WinProbability(attackerDice, defenderDice);
 }
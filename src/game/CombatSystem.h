@@ -6,7 +6,9 @@
 #define ATLAS_COMBATSYSTEM_H
 
 #include "GameData.h"
+#include "../Random.h"
 #include <random>
+#include <span>
 
 class CombatSystem
 {
@@ -14,26 +16,36 @@ public:
     explicit CombatSystem(unsigned int seed = 0);
 
     // Resolve combat between two territories
-    // Returns the combat result with all dice rolls
+    // Samples each side's dice total directly; the individual rolls are not
+    // filled in until RevealRolls is called
     CombatResult ResolveCombat(
         const TerritoryData& attacker,
         const TerritoryData& defender
     );
 
-    // Apply combat result to game state
+    // Fill in individual rolls matching the totals of a resolved combat. Call
+    // it only where the dice are displayed: the rolls come from the result's
+    // rollSeed, not the combat stream, so revealing them never changes later
+    // combats and the same result always shows the same dice. Each sequence of
+    // dice is as likely as if it had been rolled.
+    static void RevealRolls(CombatResult& result);
+
+    // Apply combat result to game state through GameState::ApplyAction, which
+    // also records the attack and settles elimination and victory
     void ApplyCombatResult(GameState& state, const CombatResult& result);
 
-    // Calculate win probability for attacker (for AI)
+    // Exact win probability for attacker (for AI), from the DiceOdds table
     [[nodiscard]] float CalculateWinProbability(int attackerDice, int defenderDice) const;
 
 private:
-    std::mt19937 _rng;
+    RandomEngine _rng;
 
-    // Roll a single die (1-6)
-    int RollDie();
+    // Total of `count` dice from a single draw on the sum distribution
+    int RollSum(int count);
 
-    // Roll multiple dice and return individual results
-    std::vector<int> RollDice(int count);
+    // Write `count` dice adding up to `total` into `rolls`, drawn one die at a
+    // time from the distribution conditioned on the remaining total
+    static void RollDiceWithTotal(RandomEngine& rng, int count, int total, std::span<uint8_t> rolls);
 };
 
 #endif // ATLAS_COMBATSYSTEM_H
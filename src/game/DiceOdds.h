@@ -0,0 +1,167 @@
+//
+// DiceOdds.h - Exact dice combat odds, computed at compile time
+//
+
+#ifndef ATLAS_DICEODDS_H
+#define ATLAS_DICEODDS_H
+
+#include "GameData.h"
+#include <array>
+#include <cstdint>
+
+namespace DiceOdds {
+    constexpr int MAX_SUM = MAX_DICE_PER_TERRITORY * 6;
+
+    // Number of ways n d6 can total each sum (6^8 fits comfortably in 32 bits)
+    using SumWays = std::array<uint32_t, MAX_SUM + 1>;
+
+    constexpr std::array<SumWays, MAX_DICE_PER_TERRITORY + 1> BuildSumWays() {
+        std::array<SumWays, MAX_DICE_PER_TERRITORY + 1> ways{};
+        ways[0][0] = 1;
+        for (int n = 1; n <= MAX_DICE_PER_TERRITORY; n++) {
+            for (int sum = 0; sum <= MAX_SUM; sum++) {
+                for (int face = 1; face <= 6 && face <= sum; face++) {
+                    ways[n][sum] += ways[n - 1][sum - face];
+                }
+            }
+        }
+        return ways;
+    }
+
+    // SUM_WAYS[n][s]: ways for n dice to total s, out of 6^n
+    inline constexpr auto SUM_WAYS = BuildSumWays();
+
+    constexpr std::array<SumWays, MAX_DICE_PER_TERRITORY + 1> BuildSumCdf() {
+        std::array<SumWays, MAX_DICE_PER_TERRITORY + 1> cdf{};
+        for (int n = 0; n <= MAX_DICE_PER_TERRITORY; n++) {
+            uint32_t running = 0;
+            for (int sum = 0; sum <= MAX_SUM; sum++) {
+                running += SUM_WAYS[n][sum];
+                cdf[n][sum] = running;
+            }
+        }
+        return cdf;
+    }
+
+    // SUM_CDF[n][s]: ways for n dice to total s or less, out of 6^n
+    inline constexpr auto SUM_CDF = BuildSumCdf();
+
+    constexpr uint64_t PowSix(int n) {
+        uint64_t value = 1;
+        for (int i = 0; i < n; i++) value *= 6;
+        return value;
+    }
+
+    constexpr std::array<uint32_t, MAX_DICE_PER_TERRITORY + 1> BuildOutcomeCounts() {
+        std::array<uint32_t, MAX_DICE_PER_TERRITORY + 1> counts{};
+        for (int n = 0; n <= MAX_DICE_PER_TERRITORY; n++) counts[n] = static_cast<uint32_t>(PowSix(n));
+        return counts;
+    }
+
+    // OUTCOME_COUNT[n] = 6^n, the number of equally likely rolls of n dice
+    inline constexpr auto OUTCOME_COUNT = BuildOutcomeCounts();
+
+    // P(sum of a d6 > sum of d d6); ties go to the defender
+    constexpr double ExactWinProbability(int attackerDice, int defenderDice) {
+        uint64_t wins = 0;
+        uint64_t defenderBelow = 0; // Ways for the defender to roll less than the attacker's sum
+        for (int sum = 0; sum <= MAX_SUM; sum++) {
+            wins += static_cast<uint64_t>(SUM_WAYS[attackerDice][sum]) * defenderBelow;
+            defenderBelow += SUM_WAYS[defenderDice][sum];
+        }
+        return static_cast<double>(wins) /
+               static_cast<double>(PowSix(attackerDice) * PowSix(defenderDice));
+    }
+
+    using WinTable = std::array<std::array<float, MAX_DICE_PER_TERRITORY + 1>, MAX_DICE_PER_TERRITORY + 1>;
+
+    constexpr WinTable BuildWinTable() {
+        WinTable table{};
+        for (int a = 1; a <= MAX_DICE_PER_TERRITORY; a++) {
+            for (int d = 1; d <= MAX_DICE_PER_TERRITORY; d++) {
+                table[a][d] = static_cast<float>(ExactWinProbability(a, d));
+            }
+        }
+        return table;
+    }
+
+    // WIN_PROBABILITY[attackerDice][defenderDice]; row and column 0 are unused
+    inline constexpr WinTable WIN_PROBABILITY = BuildWinTable();
+
+    // Total of n dice for a uniform draw in [0, 6^n): the first sum whose
+    // cumulative count exceeds the draw, i.e. the number of sums whose count
+    // does not. Counting over the whole row is branchless and vectorizes,
+    // which beats a binary search on random dice counts.
+    [[nodiscard]] constexpr int SumFromDraw(int diceCount, uint32_t draw) {
+        const SumWays &cdf = SUM_CDF[diceCount];
+        int sum = 0;
+        for (int s = 0; s <= MAX_SUM; s++) {
+            sum += cdf[s] <= draw;
+        }
+        return sum;
+    }
+
+    // Draws are scaled from the top DRAW_BITS of 64 random bits; 6^8 < 2^21,
+    // so draw * 6^n fits in 64 bits and the rounding bias stays below 2^-22
+    constexpr int DRAW_BITS = 43;
+    constexpr int GUIDE_BITS = 6;
+
+    using SumGuide = std::array<std::array<uint8_t, 1 << GUIDE_BITS>, MAX_DICE_PER_TERRITORY + 1>;
+
+    constexpr SumGuide BuildSumGuide() {
+        SumGuide guide{};
+        for (int n = 0; n <= MAX_DICE_PER_TERRITORY; n++) {
+            for (uint64_t bucket = 0; bucket < (1u << GUIDE_BITS); bucket++) {
+                guide[n][bucket] = static_cast<uint8_t>(
+                    SumFromDraw(n, static_cast<uint32_t>((bucket * OUTCOME_COUNT[n]) >> GUIDE_BITS)));
+            }
+        }
+        return guide;
+    }
+
+    // SUM_GUIDE[n][b]: lowest total of n dice for draws whose top GUIDE_BITS are b
+    inline constexpr SumGuide SUM_GUIDE = BuildSumGuide();
+
+    // Total of n dice from 64 uniform random bits: one engine call per side.
+    // The guide table starts the search within a step or so of the answer.
+    [[nodiscard]] constexpr int SumFromBits(int diceCount, uint64_t bits) {
+        const uint64_t high = bits >> (64 - DRAW_BITS);
+        const auto draw = static_cast<uint32_t>((high * OUTCOME_COUNT[diceCount]) >> DRAW_BITS);
+        const SumWays &cdf = SUM_CDF[diceCount];
+        int sum = SUM_GUIDE[diceCount][high >> (DRAW_BITS - GUIDE_BITS)];
+        while (cdf[sum] <= draw) sum++;
+        return sum;
+    }
+
+    static_assert(SUM_WAYS[MAX_DICE_PER_TERRITORY][MAX_SUM] == 1);
+    static_assert(SUM_CDF[MAX_DICE_PER_TERRITORY][MAX_SUM] == PowSix(MAX_DICE_PER_TERRITORY));
+    static_assert(SumFromDraw(2, 0) == 2 && SumFromDraw(2, 35) == 12 && SumFromDraw(0, 0) == 0);
+    static_assert(SumFromBits(2, 0) == 2 && SumFromBits(2, ~uint64_t{0}) == 12 && SumFromBits(0, ~uint64_t{0}) == 0);
+    static_assert(ExactWinProbability(1, 1) * 36 > 14.99 && ExactWinProbability(1, 1) * 36 < 15.01);
+
+    [[nodiscard]] constexpr float WinProbability(int attackerDice, int defenderDice) {
+        if (attackerDice <= 0 || defenderDice <= 0) return 0.0f;
+        if (attackerDice > MAX_DICE_PER_TERRITORY) attackerDice = MAX_DICE_PER_TERRITORY;
+        if (defenderDice > MAX_DICE_PER_TERRITORY) defenderDice = MAX_DICE_PER_TERRITORY;
+        return WIN_PROBABILITY[attackerDice][defenderDice];
+    }
+
+    // One possible result of an attack and the dice left on both territories
+    struct AttackOutcome {
+        float probability = 0.0f;
+        bool captured = false;
+        uint8_t attackerDiceAfter = 0; // Dice left on the attacking territory
+        uint8_t targetDiceAfter = 0;   // Dice on the target territory (attacker's if captured)
+    };
+
+    // Both outcomes of an attack: [0] = capture, [1] = repelled
+    [[nodiscard]] constexpr std::array<AttackOutcome, 2> OutcomeDistribution(int attackerDice, int defenderDice) {
+        float win = WinProbability(attackerDice, defenderDice);
+        return {{
+            {win, true, 1, static_cast<uint8_t>(attackerDice > 1 ? attackerDice - 1 : 0)},
+            {1.0f - win, false, 1, static_cast<uint8_t>(defenderDice)}
+        }};
+    }
+}
+
+#endif // ATLAS_DICEODDS_H
@@ -5,11 +5,9 @@
 #include "GameController.h"
 #include "AIController.h"
 #include "ReplaySystem.h"
-#include <queue>
-#include <unordered_set>
 #include <algorithm>
 
-#include <tracy/Tracy.hpp>
+#include "../Profiling.h"
 
 GameController::GameController()
     : _grid(HexGridConfig{}),
@@ -18,6 +16,7 @@ GameController::GameController()
 
 void GameController::InitializeGame(const GameConfig &config) {
     ZoneScoped;
+    WaitForAIDecision();
     _state = GameState{};
     _state.config = config;
 
@@ -32,6 +31,8 @@ void GameController::InitializeGame(const GameConfig &config) {
     // Initialize RNG with seed
     _generator = TerritoryGenerator(config.seed);
     _combat = CombatSystem(config.seed);
+    _reinforcementRng = MakeRandomEngine(config.seed);
+    _reinforcementRng.Jump(); // Keep clear of the combat stream, which starts from the same seed
 
     // Generate territories
     _generator.Generate(_grid, _state);
@@ -53,6 +54,29 @@ void GameController::InitializeGame(const GameConfig &config) {
     // Start game with first player
     _state.turnNumber = 1;
     StartTurn(0);
+
+    // Full copy once; later decisions only sync owners, dice and history
+    if (_aiWorker) {
+        _aiView = _state;
+    }
+}
+
+void GameController::SetAIController(AIController *ai) {
+    WaitForAIDecision();
+    _aiController = ai;
+}
+
+void GameController::SetAsyncAI(bool enabled) {
+    if (enabled == IsAsyncAI()) return;
+
+    WaitForAIDecision();
+    if (enabled) {
+        _aiWorker = std::make_unique<ThreadPool>(1);
+        _aiView = _state;
+    } else {
+        _aiWorker.reset();
+        _aiView = GameState{};
+    }
 }
 
 void GameController::StartTurn(PlayerId player) {
@@ -143,7 +167,7 @@ bool GameController::Attack(TerritoryId target) {
     action.defenderDice = defender->diceCount;
 
     // Queue the action for processing
-    _combatQueue.QueueAction(action);
+    if (!_combatQueue.QueueAction(action)) return false;
 
     // Record action to replay file if recording
     if (_replaySystem) {
@@ -169,24 +193,14 @@ void GameController::ExecuteCombat(const CombatAction& action) {
 
     // Resolve combat
     CombatResult result = _combat.ResolveCombat(*attacker, *defender);
+    // Moves dice, records the attack and settles elimination and victory
     _combat.ApplyCombatResult(_state, result);
 
-    // Record attack in history for AI retribution/honor system
-    _state.attackHistory.RecordAttack(
-        action.attackerPlayer,
-        defender->owner,
-        _state.turnNumber,
-        result.attackerWins);
-    _state.attackHistory.PruneOldEntries(_state.turnNumber);
-
-    // Store result for display
+    // Store result for display; whoever shows the dice reveals them with
+    // CombatSystem::RevealRolls
     _state.lastCombat = result;
     _state.combatPending = true;
     _state.combatAnimTimer = 1.5f; // Show result for 1.5 seconds
-
-    // Check for elimination and victory
-    CheckElimination();
-    CheckVictory();
 }
 
 void GameController::ProcessCombatQueue() {
@@ -235,8 +249,7 @@ bool GameController::CanAttack(TerritoryId from, TerritoryId to) const {
     if (defender->owner == _state.currentPlayer) return false;
 
     // Must be neighbors
-    auto &neighbors = attacker->neighbors;
-    return std::find(neighbors.begin(), neighbors.end(), to) != neighbors.end();
+    return _state.adjacency.AreAdjacent(from, to);
 }
 
 std::vector<TerritoryId> GameController::GetValidTargets(TerritoryId from) const {
@@ -245,7 +258,7 @@ std::vector<TerritoryId> GameController::GetValidTargets(TerritoryId from) const
     const TerritoryData *attacker = _state.GetTerritory(from);
     if (!attacker || !attacker->CanAttack()) return targets;
 
-    for (TerritoryId neighbor: attacker->neighbors) {
+    for (TerritoryId neighbor: _state.GetNeighbors(from)) {
         if (CanAttack(from, neighbor)) {
             targets.push_back(neighbor);
         }
@@ -268,19 +281,25 @@ void GameController::Update(float deltaTime) {
         }
     }
 
-    // Process combat queue
-    _combatQueue.Update(deltaTime);
-    if (auto action = _combatQueue.PopNextAction()) {
-        ExecuteCombat(*action);
+    if (_fastForward) {
+        DrainCombatQueue();
+        RunAITurn();
+        return;
     }
 
+    // Process combat queue (every queued action when there is no delay)
+    _combatQueue.Update(deltaTime);
+    _combatQueue.DrainReady([this](const CombatAction &action) { ExecuteCombat(action); });
+
     // Don't process AI turns or allow turn end while queue is processing
     if (_combatQueue.HasPendingActions()) {
         return;
     }
 
     // Handle AI turn
-    if (_state.phase == TurnPhase::AITurn && _aiController) {
+    if (_state.phase == TurnPhase::AITurn && _aiController && _aiWorker) {
+        UpdateAsyncAI(deltaTime);
+    } else if (_state.phase == TurnPhase::AITurn && _aiController) {
         _aiThinkTimer -= deltaTime;
         if (_aiThinkTimer <= 0) {
             // Let AI take an action
@@ -297,118 +316,136 @@ void GameController::Update(float deltaTime) {
     }
 }
 
-int GameController::CalculateReinforcements(PlayerId player) {
-    return FindLargestContiguousRegion(player);
-}
-
-void GameController::DistributeReinforcements(PlayerId player, int diceCount) {
-    // Get all territories owned by player that aren't full
-    std::vector<TerritoryId> eligibleTerritories;
-    for (const auto &t: _state.territories) {
-        if (t.owner == player && t.diceCount < MAX_DICE_PER_TERRITORY) {
-            eligibleTerritories.push_back(t.id);
+void GameController::UpdateAsyncAI(float deltaTime) {
+    if (_pendingAIDecision.valid()) {
+        // Keep rendering until the worker has decided
+        if (_pendingAIDecision.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;
         }
-    }
 
-    if (eligibleTerritories.empty()) return;
-
-    // Distribute dice randomly
-    std::mt19937 rng(std::random_device{}());
-    while (diceCount > 0 && !eligibleTerritories.empty()) {
-        int idx = std::uniform_int_distribution<>(
-            0, static_cast<int>(eligibleTerritories.size()) - 1)(rng);
+        std::optional<CombatAction> action = _pendingAIDecision.get();
+        if (_state.phase != TurnPhase::AITurn || _state.currentPlayer != _pendingAIPlayer) {
+            return; // Turn moved on while the AI was thinking
+        }
 
-        TerritoryData *t = _state.GetTerritory(eligibleTerritories[idx]);
-        if (t && t->diceCount < MAX_DICE_PER_TERRITORY) {
-            t->diceCount++;
-            diceCount--;
+        bool tookAction = false;
+        if (action) {
+            _state.selectedTerritory = action->attackerId;
+            tookAction = Attack(action->defenderId);
+        }
 
-            // Remove if now full
-            if (t->diceCount >= MAX_DICE_PER_TERRITORY) {
-                eligibleTerritories.erase(eligibleTerritories.begin() + idx);
-            }
+        if (tookAction) {
+            _aiThinkTimer = AI_THINK_DELAY;
         } else {
-            eligibleTerritories.erase(eligibleTerritories.begin() + idx);
+            EndTurn();
         }
+        return;
     }
-}
 
-int GameController::FindLargestContiguousRegion(PlayerId player) {
-    ZoneScoped;
-    // Get all territories owned by player
-    std::vector<TerritoryId> playerTerritories;
-    for (const auto &t: _state.territories) {
-        if (t.owner == player) {
-            playerTerritories.push_back(t.id);
-        }
-    }
+    _aiThinkTimer -= deltaTime;
+    if (_aiThinkTimer > 0) return;
 
-    if (playerTerritories.empty()) return 0;
+    // Bring the worker's copy up to date, then decide off the main thread
+    _aiSnapshot.Capture(_state);
+    _aiSnapshot.Restore(_aiView);
+    _pendingAIPlayer = _state.currentPlayer;
 
-    std::unordered_set<TerritoryId> visited;
-    int largestRegion = 0;
+    AIController *ai = _aiController;
+    PlayerId player = _pendingAIPlayer;
+    _pendingAIDecision = _aiWorker->Submit([this, ai, player]() {
+        return ai->DecideAction(_aiView, player);
+    });
+}
 
-    // BFS from each unvisited territory
-    for (TerritoryId start: playerTerritories) {
-        if (visited.find(start) != visited.end()) continue;
+void GameController::WaitForAIDecision() {
+    if (_pendingAIDecision.valid()) {
+        _pendingAIDecision.wait();
+        _pendingAIDecision = {};
+    }
+}
 
-        // BFS to find connected region
-        std::queue<TerritoryId> queue;
-        queue.push(start);
-        visited.insert(start);
-        int regionSize = 0;
+void GameController::DrainCombatQueue() {
+    while (_combatQueue.HasPendingActions()) {
+        // Elapse a full processing delay so the next action is always ready
+        _combatQueue.Update(_combatQueue.GetProcessingDelay());
+        if (auto action = _combatQueue.PopNextAction()) {
+            ExecuteCombat(*action);
+        }
+    }
+}
 
-        while (!queue.empty()) {
-            TerritoryId current = queue.front();
-            queue.pop();
-            regionSize++;
+void GameController::RunAITurn() {
+    ZoneScoped;
+    if (_state.phase != TurnPhase::AITurn || !_aiController) return;
 
-            const TerritoryData *t = _state.GetTerritory(current);
-            if (!t) continue;
+    // An async decision in flight was made for a view that is about to go stale
+    WaitForAIDecision();
 
-            for (TerritoryId neighbor: t->neighbors) {
-                const TerritoryData *nt = _state.GetTerritory(neighbor);
-                if (nt && nt->owner == player &&
-                    visited.find(neighbor) == visited.end()) {
-                    visited.insert(neighbor);
-                    queue.push(neighbor);
-                }
-            }
+    PlayerId player = _state.currentPlayer;
+    while (_state.phase == TurnPhase::AITurn && _state.currentPlayer == player) {
+        if (!_aiController->TakeAction(player)) {
+            // AI is done, end turn
+            EndTurn();
+            break;
         }
+        DrainCombatQueue();
+    }
+}
 
-        largestRegion = std::max(largestRegion, regionSize);
+bool GameController::RunUntil(int turnNumber) {
+    ZoneScoped;
+    DrainCombatQueue();
+
+    while (!_state.IsGameOver() &&
+           _state.turnNumber < turnNumber &&
+           _state.phase == TurnPhase::AITurn &&
+           _aiController) {
+        RunAITurn();
     }
 
-    return largestRegion;
+    return _state.IsGameOver();
+}
+
+int GameController::CalculateReinforcements(PlayerId player) const {
+    return _state.GetReinforcements(player);
 }
 
-void GameController::CheckVictory() {
-    // Check if one player owns all territories
-    PlayerId firstOwner = PLAYER_NONE;
+void GameController::DistributeReinforcements(PlayerId player, int diceCount) {
+    const TerritoryArrays &arrays = _state.territoryArrays;
 
-    for (const auto &t: _state.territories) {
-        if (firstOwner == PLAYER_NONE) {
-            firstOwner = t.owner;
-        } else if (t.owner != firstOwner) {
-            return; // Multiple owners, no victory
+    // Get all territories owned by player that aren't full
+    std::vector<TerritoryId> eligibleTerritories;
+    for (size_t i = 0; i < arrays.Size(); i++) {
+        if (arrays.owner[i] == player && arrays.diceCount[i] < MAX_DICE_PER_TERRITORY) {
+            eligibleTerritories.push_back(static_cast<TerritoryId>(i));
         }
     }
 
-    if (firstOwner != PLAYER_NONE) {
-        _state.winner = firstOwner;
-        _state.phase = TurnPhase::GameOver;
-    }
-}
+    if (eligibleTerritories.empty()) return;
+
+    // Distribute dice randomly
+    while (diceCount > 0 && !eligibleTerritories.empty()) {
+        int idx = std::uniform_int_distribution<>(
+            0, static_cast<int>(eligibleTerritories.size()) - 1)(_reinforcementRng);
 
-void GameController::CheckElimination() {
-    // Check each player
-    for (int p = 0; p < _state.config.playerCount; p++) {
-        if (_state.players[p].isEliminated) continue;
+        TerritoryId tid = eligibleTerritories[idx];
+        uint8_t dice = arrays.diceCount[tid];
+        if (dice < MAX_DICE_PER_TERRITORY) {
+            _state.SetTerritoryDice(tid, dice + 1);
+            diceCount--;
 
-        int territories = _state.CountTerritoriesOwned(static_cast<PlayerId>(p));
-        if (territories == 0) {
-            _state.players[p].isEliminated = true;
-            _state.activePlayerCount--;
+            // Remove if now full
+            if (dice + 1 >= MAX_DICE_PER_TERRITORY) {
+                eligibleTerritories.erase(eligibleTerritories.begin() + idx);
+            }
+        } else {
+            eligibleTerritories.erase(eligibleTerritories.begin() + idx);
         }
     }
 }
+
+int GameController::FindLargestContiguousRegion(PlayerId player) const {
+    // Regions are maintained incrementally as territories change hands
+    return _state.regions.LargestRegion(player);
+}
+
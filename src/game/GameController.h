@@ -6,10 +6,16 @@
 #define ATLAS_GAMECONTROLLER_H
 
 #include "GameData.h"
+#include "GameSnapshot.h"
 #include "CombatSystem.h"
 #include "CombatQueue.h"
+#include "../ThreadPool.h"
 #include "../hex/HexGrid.h"
 #include "../hex/TerritoryGenerator.h"
+#include <future>
+#include <limits>
+#include <memory>
+#include <optional>
 
 class AIController;  // Forward declaration
 class ReplaySystem;  // Forward declaration
@@ -23,7 +29,7 @@ public:
     void InitializeGame(const GameConfig& config);
 
     // Set AI controller reference
-    void SetAIController(AIController* ai) { _aiController = ai; }
+    void SetAIController(AIController* ai);
 
     // Set replay system reference
     void SetReplaySystem(ReplaySystem* replay) { _replaySystem = replay; }
@@ -52,6 +58,23 @@ public:
     // Update (call each frame)
     void Update(float deltaTime);
 
+    // Fast-forward mode: Update() ignores frame timing, resolving every queued
+    // combat and running the current AI player's whole turn in a single call
+    void SetFastForward(bool enabled) { _fastForward = enabled; }
+    [[nodiscard]] bool IsFastForward() const { return _fastForward; }
+
+    // Async AI: Update() hands each AI decision to a worker thread, which reads
+    // a snapshot copy of the state, and applies the chosen attack once the
+    // result is ready. Frames keep rendering however long the AI thinks.
+    // Fast-forward and RunUntil still decide synchronously.
+    void SetAsyncAI(bool enabled);
+    [[nodiscard]] bool IsAsyncAI() const { return _aiWorker != nullptr; }
+
+    // Run AI turns back to back until the given turn number starts, the game
+    // ends, or a human player has to act. Returns true if the game is over.
+    bool RunUntil(int turnNumber);
+    bool RunUntilGameOver() { return RunUntil(std::numeric_limits<int>::max()); }
+
     // Check if attack is valid
     [[nodiscard]] bool CanAttack(TerritoryId from, TerritoryId to) const;
 
@@ -59,7 +82,7 @@ public:
     [[nodiscard]] std::vector<TerritoryId> GetValidTargets(TerritoryId from) const;
 
     // Get size of largest contiguous territory region for a player (for UI)
-    [[nodiscard]] int FindLargestContiguousRegion(PlayerId player);
+    [[nodiscard]] int FindLargestContiguousRegion(PlayerId player) const;
 
 private:
     GameState _state;
@@ -67,31 +90,45 @@ private:
     CombatSystem _combat;
     CombatQueue _combatQueue;
     TerritoryGenerator _generator;
+    RandomEngine _reinforcementRng; // Seeded per game so reinforcements replay with the seed
     AIController* _aiController = nullptr;
     ReplaySystem* _replaySystem = nullptr;
 
     // AI timing
     float _aiThinkTimer = 0.0f;
     static constexpr float AI_THINK_DELAY = 0.1f;  // Delay between AI actions
+    bool _fastForward = false;
+
+    // Async AI decisions: the worker reads _aiView, which is synced from _state
+    // through _aiSnapshot right before each decision
+    GameState _aiView;
+    GameSnapshot _aiSnapshot;
+    std::future<std::optional<CombatAction>> _pendingAIDecision;
+    PlayerId _pendingAIPlayer = PLAYER_NONE;
+    std::unique_ptr<ThreadPool> _aiWorker; // Declared last: joins before the view is destroyed
 
     // Turn flow
     void StartTurn(PlayerId player);
     void AdvanceToNextPlayer();
 
     // Reinforcement
-    int CalculateReinforcements(PlayerId player);
+    int CalculateReinforcements(PlayerId player) const;
     void DistributeReinforcements(PlayerId player, int diceCount);
 
-    // Victory
-    void CheckVictory();
-    void CheckElimination();
-
     // Update valid targets based on selection
     void UpdateValidTargets();
 
     // Combat queue processing
     void ProcessCombatQueue();
     void ExecuteCombat(const CombatAction& action);
+
+    // Fast-forward helpers
+    void DrainCombatQueue();
+    void RunAITurn();
+
+    // Async AI helpers
+    void UpdateAsyncAI(float deltaTime);
+    void WaitForAIDecision();
 };
 
 #endif // ATLAS_GAMECONTROLLER_H
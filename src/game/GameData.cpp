@@ -0,0 +1,259 @@
+//
+// GameData.cpp - Out-of-line game state helpers
+//
+
+#include "GameData.h"
+#include "Zobrist.h"
+
+void GameState::SetTerritoryOwner(TerritoryId id, PlayerId owner) {
+    PlayerId oldOwner = territoryArrays.owner[id];
+    if (oldOwner == owner) return;
+
+    // The territory and its neighbors may change border status
+    auto neighbors = adjacency.Neighbors(id);
+    AccumulateAggregates(id, -1);
+    for (TerritoryId neighbor: neighbors) AccumulateAggregates(neighbor, -1);
+
+    const uint8_t dice = territoryArrays.diceCount[id];
+    territoryHash ^= Zobrist::TerritoryKey(id, oldOwner, dice) ^ Zobrist::TerritoryKey(id, owner, dice);
+
+    territories[id].owner = owner;
+    territoryArrays.owner[id] = owner;
+
+    territoryArrays.isBorder[id] = ComputeIsBorder(id);
+    AccumulateAggregates(id, +1);
+    for (TerritoryId neighbor: neighbors) {
+        territoryArrays.isBorder[neighbor] = ComputeIsBorder(neighbor);
+        AccumulateAggregates(neighbor, +1);
+    }
+
+    regions.OnOwnerChanged(id, oldOwner, territoryArrays, adjacency);
+}
+
+void GameState::SetTerritoryDice(TerritoryId id, uint8_t diceCount) {
+    int delta = static_cast<int>(diceCount) - territoryArrays.diceCount[id];
+    if (delta == 0) return;
+
+    const PlayerId owner = territoryArrays.owner[id];
+    territoryHash ^= Zobrist::TerritoryKey(id, owner, territoryArrays.diceCount[id]) ^
+                     Zobrist::TerritoryKey(id, owner, diceCount);
+
+    AccumulateAggregates(id, -1);
+    territories[id].diceCount = diceCount;
+    territoryArrays.diceCount[id] = diceCount;
+    AccumulateAggregates(id, +1);
+
+    regions.OnDiceChanged(id, delta);
+}
+
+void GameState::RebuildTerritoryArrays() {
+    const size_t count = territories.size();
+    territoryArrays.owner.resize(count);
+    territoryArrays.diceCount.resize(count);
+    territoryArrays.hexCount.resize(count);
+    territoryArrays.isBorder.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        territoryArrays.owner[i] = territories[i].owner;
+        territoryArrays.diceCount[i] = territories[i].diceCount;
+        territoryArrays.hexCount[i] = static_cast<uint16_t>(territories[i].hexes.size());
+    }
+
+    playerAggregates.fill(PlayerAggregates{});
+    territoryHash = 0;
+    for (size_t i = 0; i < count; i++) {
+        territoryArrays.isBorder[i] = ComputeIsBorder(static_cast<TerritoryId>(i));
+        AccumulateAggregates(static_cast<TerritoryId>(i), +1);
+        territoryHash ^= Zobrist::TerritoryKey(static_cast<TerritoryId>(i), territoryArrays.owner[i],
+                                               territoryArrays.diceCount[i]);
+    }
+
+    regions.Rebuild(territoryArrays, adjacency);
+}
+
+uint64_t GameState::GetHash() const {
+    return territoryHash ^ Zobrist::PlayerKey(currentPlayer);
+}
+
+UndoRecord GameState::ApplyAction(const CombatAction &action, bool attackerWins) {
+    UndoRecord record;
+    if (action.attackerId >= territories.size() || action.defenderId >= territories.size()) {
+        return record;
+    }
+
+    record.attackerId = action.attackerId;
+    record.defenderId = action.defenderId;
+    record.attackerOwner = territoryArrays.owner[action.attackerId];
+    record.defenderOwner = territoryArrays.owner[action.defenderId];
+    record.attackerDice = territoryArrays.diceCount[action.attackerId];
+    record.defenderDice = territoryArrays.diceCount[action.defenderId];
+    record.previousWinner = winner;
+    record.previousPhase = phase;
+
+    // The only combat rules: CombatSystem::ApplyCombatResult plays real games through here
+    if (attackerWins) {
+        SetTerritoryOwner(action.defenderId, record.attackerOwner);
+        SetTerritoryDice(action.defenderId, static_cast<uint8_t>(record.attackerDice - 1));
+    }
+    SetTerritoryDice(action.attackerId, 1);
+
+    attackHistory.RecordAttack(record.attackerOwner, record.defenderOwner, turnNumber);
+
+    // Only the defender can have been eliminated, and only the attacker can have won
+    if (record.defenderOwner < MAX_PLAYERS && !players[record.defenderOwner].isEliminated &&
+        CountTerritoriesOwned(record.defenderOwner) == 0) {
+        players[record.defenderOwner].isEliminated = true;
+        activePlayerCount--;
+        record.defenderEliminated = true;
+    }
+    if (CountTerritoriesOwned(record.attackerOwner) == static_cast<int>(territories.size())) {
+        winner = record.attackerOwner;
+        phase = TurnPhase::GameOver;
+    }
+
+    return record;
+}
+
+void GameState::Undo(const UndoRecord &record) {
+    if (record.attackerId == TERRITORY_NONE) return;
+
+    winner = record.previousWinner;
+    phase = record.previousPhase;
+    if (record.defenderEliminated) {
+        players[record.defenderOwner].isEliminated = false;
+        activePlayerCount++;
+    }
+
+    attackHistory.ForgetAttack(record.attackerOwner, record.defenderOwner, turnNumber);
+
+    SetTerritoryOwner(record.defenderId, record.defenderOwner);
+    SetTerritoryDice(record.defenderId, record.defenderDice);
+    SetTerritoryDice(record.attackerId, record.attackerDice);
+}
+
+bool GameState::ComputeIsBorder(TerritoryId id) const {
+    PlayerId owner = territoryArrays.owner[id];
+    for (TerritoryId neighbor: adjacency.Neighbors(id)) {
+        if (territoryArrays.owner[neighbor] != owner) return true;
+    }
+    return false;
+}
+
+void GameState::AccumulateAggregates(TerritoryId id, int sign) {
+    PlayerId owner = territoryArrays.owner[id];
+    if (owner >= MAX_PLAYERS) return;
+
+    PlayerAggregates &totals = playerAggregates[owner];
+    bool border = territoryArrays.isBorder[id] != 0;
+    totals.territories += sign;
+    totals.dice += sign * territoryArrays.diceCount[id];
+    totals.borderTerritories += sign * border;
+    totals.attackCapableTerritories += sign * (border && territoryArrays.diceCount[id] >= 2);
+}
+
+void TerritoryRegions::Rebuild(const TerritoryArrays &arrays, const TerritoryGraph &graph) {
+    const size_t count = arrays.Size();
+    _parent.resize(count);
+    _size.resize(count);
+    _dice.resize(count);
+    _largest.fill(0);
+
+    for (size_t i = 0; i < count; i++) {
+        MakeSingleton(static_cast<TerritoryId>(i), arrays);
+    }
+
+    // Union each same-owner edge once (from its lower-numbered end)
+    for (size_t i = 0; i < count; i++) {
+        PlayerId owner = arrays.owner[i];
+        if (owner >= MAX_PLAYERS) continue;
+
+        _largest[owner] = std::max(_largest[owner], 1);
+        for (TerritoryId neighbor: graph.Neighbors(static_cast<TerritoryId>(i))) {
+            if (neighbor > i && arrays.owner[neighbor] == owner) {
+                Union(static_cast<TerritoryId>(i), neighbor, owner);
+            }
+        }
+    }
+}
+
+void TerritoryRegions::OnOwnerChanged(TerritoryId id, PlayerId oldOwner,
+                                      const TerritoryArrays &arrays, const TerritoryGraph &graph) {
+    if (id >= _parent.size()) return;
+
+    // Detach the territory, then rebuild the previous owner's regions in case
+    // losing it split one of them. Nodes of that player that pointed at it are
+    // reset by the rebuild.
+    MakeSingleton(id, arrays);
+    if (oldOwner < MAX_PLAYERS) {
+        RebuildPlayer(oldOwner, arrays, graph);
+    }
+
+    // Gaining a territory can only merge regions
+    PlayerId newOwner = arrays.owner[id];
+    if (newOwner < MAX_PLAYERS) {
+        _largest[newOwner] = std::max(_largest[newOwner], 1);
+        UnionWithOwnedNeighbors(id, newOwner, arrays, graph);
+    }
+}
+
+void TerritoryRegions::OnDiceChanged(TerritoryId id, int delta) {
+    if (id >= _parent.size() || delta == 0) return;
+    TerritoryId root = RegionOf(id);
+    _dice[root] = static_cast<uint32_t>(static_cast<int>(_dice[root]) + delta);
+}
+
+TerritoryId TerritoryRegions::RegionOf(TerritoryId id) const {
+    // Union by size keeps trees shallow, so no path compression is needed
+    while (_parent[id] != id) {
+        id = _parent[id];
+    }
+    return id;
+}
+
+void TerritoryRegions::MakeSingleton(TerritoryId id, const TerritoryArrays &arrays) {
+    _parent[id] = id;
+    _size[id] = 1;
+    _dice[id] = arrays.diceCount[id];
+}
+
+void TerritoryRegions::Union(TerritoryId a, TerritoryId b, PlayerId owner) {
+    TerritoryId rootA = RegionOf(a);
+    TerritoryId rootB = RegionOf(b);
+    if (rootA == rootB) return;
+
+    if (_size[rootA] < _size[rootB]) std::swap(rootA, rootB);
+    _parent[rootB] = rootA;
+    _size[rootA] = static_cast<uint16_t>(_size[rootA] + _size[rootB]);
+    _dice[rootA] += _dice[rootB];
+
+    _largest[owner] = std::max(_largest[owner], static_cast<int>(_size[rootA]));
+}
+
+void TerritoryRegions::UnionWithOwnedNeighbors(TerritoryId id, PlayerId owner,
+                                               const TerritoryArrays &arrays, const TerritoryGraph &graph) {
+    for (TerritoryId neighbor: graph.Neighbors(id)) {
+        if (arrays.owner[neighbor] == owner) {
+            Union(id, neighbor, owner);
+        }
+    }
+}
+
+void TerritoryRegions::RebuildPlayer(PlayerId player, const TerritoryArrays &arrays, const TerritoryGraph &graph) {
+    const size_t count = arrays.Size();
+    const PlayerId *owner = arrays.owner.data();
+
+    for (size_t i = 0; i < count; i++) {
+        if (owner[i] == player) MakeSingleton(static_cast<TerritoryId>(i), arrays);
+    }
+
+    _largest[player] = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (owner[i] != player) continue;
+
+        _largest[player] = std::max(_largest[player], 1);
+        for (TerritoryId neighbor: graph.Neighbors(static_cast<TerritoryId>(i))) {
+            if (neighbor > i && owner[neighbor] == player) {
+                Union(static_cast<TerritoryId>(i), neighbor, player);
+            }
+        }
+    }
+}
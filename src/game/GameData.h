@@ -7,10 +7,12 @@
 
 #include "../hex/HexCoord.h"
 #include <array>
+#include <span>
 #include <vector>
 #include <unordered_map>
 #include <string>
 #include <algorithm>
+#include <type_traits>
 
 // Type aliases for clarity
 using PlayerId = uint8_t;
@@ -56,31 +58,117 @@ struct PlayerData {
 };
 
 // Territory data (a contiguous group of hexes)
+// owner and diceCount are mirrored in GameState::territoryArrays, so change them
+// through GameState::SetTerritoryOwner/SetTerritoryDice once the map is built
 struct TerritoryData {
     TerritoryId id = TERRITORY_NONE;
     PlayerId owner = PLAYER_NONE;
     uint8_t diceCount = 1;
     std::vector<HexCoord> hexes;
-    std::vector<TerritoryId> neighbors;
     HexCoord centerHex;
 
     [[nodiscard]] bool IsOwnedBy(PlayerId player) const { return owner == player; }
     [[nodiscard]] bool CanAttack() const { return diceCount >= 2; }
 };
 
+// Dense hex -> territory lookup over the rectangular offset grid (see HexOffset).
+// Hexes outside the grid or not in any territory map to TERRITORY_NONE.
+struct HexTerritoryMap {
+    int width = 0;
+    int height = 0;
+    std::vector<TerritoryId> cells;
+
+    void Reset(int gridWidth, int gridHeight) {
+        width = std::max(0, gridWidth);
+        height = std::max(0, gridHeight);
+        cells.assign(static_cast<size_t>(width) * height, TERRITORY_NONE);
+    }
+
+    void Clear() {
+        width = 0;
+        height = 0;
+        cells.clear();
+    }
+
+    // Cell index for a coordinate, or -1 if it lies outside the grid
+    [[nodiscard]] int IndexOf(const HexCoord &coord) const {
+        int row = HexOffset::Row(coord);
+        if (row < 0 || row >= height) return -1;
+        int column = HexOffset::Column(coord);
+        if (column < 0 || column >= width) return -1;
+        return row * width + column;
+    }
+
+    [[nodiscard]] TerritoryId Get(const HexCoord &coord) const {
+        int index = IndexOf(coord);
+        return index < 0 ? TERRITORY_NONE : cells[index];
+    }
+
+    [[nodiscard]] bool Contains(const HexCoord &coord) const { return Get(coord) != TERRITORY_NONE; }
+
+    void Set(const HexCoord &coord, TerritoryId id) {
+        int index = IndexOf(coord);
+        if (index >= 0) cells[index] = id;
+    }
+
+    void Erase(const HexCoord &coord) { Set(coord, TERRITORY_NONE); }
+};
+
+// Territory adjacency in compressed-sparse-row form: the neighbors of territory t
+// are neighbors[offsets[t] .. offsets[t + 1]), sorted by ID
+struct TerritoryGraph {
+    std::vector<uint32_t> offsets;
+    std::vector<TerritoryId> neighbors;
+
+    void Clear() {
+        offsets.clear();
+        neighbors.clear();
+    }
+
+    [[nodiscard]] size_t TerritoryCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    [[nodiscard]] std::span<const TerritoryId> Neighbors(TerritoryId id) const {
+        if (id >= TerritoryCount()) return {};
+        return {neighbors.data() + offsets[id], neighbors.data() + offsets[id + 1]};
+    }
+
+    [[nodiscard]] int Degree(TerritoryId id) const {
+        return static_cast<int>(Neighbors(id).size());
+    }
+
+    [[nodiscard]] bool AreAdjacent(TerritoryId a, TerritoryId b) const {
+        auto list = Neighbors(a);
+        return std::binary_search(list.begin(), list.end(), b);
+    }
+};
+
 // Combat result for display/animation
 struct CombatResult {
     TerritoryId attackerId = TERRITORY_NONE;
     TerritoryId defenderId = TERRITORY_NONE;
     PlayerId attackerPlayer = PLAYER_NONE;
     PlayerId defenderPlayer = PLAYER_NONE;
-    std::vector<int> attackerRolls;
-    std::vector<int> defenderRolls;
+    uint8_t attackerDiceCount = 0;
+    uint8_t defenderDiceCount = 0;
+    bool rollsRevealed = false; // Rolls below are filled in by CombatSystem::RevealRolls
+    std::array<uint8_t, MAX_DICE_PER_TERRITORY> attackerRolls{}; // First attackerDiceCount are used
+    std::array<uint8_t, MAX_DICE_PER_TERRITORY> defenderRolls{}; // First defenderDiceCount are used
     int attackerTotal = 0;
     int defenderTotal = 0;
     bool attackerWins = false;
+    uint64_t rollSeed = 0; // Drawn with the totals; RevealRolls derives the rolls from it
+
+    [[nodiscard]] std::span<const uint8_t> AttackerRolls() const {
+        return {attackerRolls.data(), rollsRevealed ? attackerDiceCount : size_t{0}};
+    }
+
+    [[nodiscard]] std::span<const uint8_t> DefenderRolls() const {
+        return {defenderRolls.data(), rollsRevealed ? defenderDiceCount : size_t{0}};
+    }
 };
 
+static_assert(std::is_trivially_copyable_v<CombatResult>);
+
 // Pending combat action - represents an intended attack before resolution
 struct CombatAction {
     TerritoryId attackerId = TERRITORY_NONE;
@@ -90,50 +178,118 @@ struct CombatAction {
     uint8_t defenderDice = 0;
 };
 
-// Attack history entry for tracking inter-player aggression
-struct AttackHistoryEntry {
-    PlayerId attacker = PLAYER_NONE;
-    PlayerId defender = PLAYER_NONE;
-    int turnNumber = 0;
-    bool wasSuccessful = false;
-};
-
-// Attack history tracking for retribution/honor system
+// Attack history tracking for retribution/honor system.
+// A ring of per-turn attacker x defender counters covering the remembered
+// turns, so queries are O(MEMORY_TURNS) and the whole history is a fixed,
+// trivially copyable block.
 struct AttackHistory {
-    std::vector<AttackHistoryEntry> entries;
     static constexpr int MEMORY_TURNS = 5;  // How many turns back to remember
+    static constexpr int TURN_SLOTS = MEMORY_TURNS + 1; // Current turn plus the remembered ones
+
+    using CounterMatrix = std::array<std::array<uint16_t, MAX_PLAYERS>, MAX_PLAYERS>;
+
+    std::array<int32_t, TURN_SLOTS> slotTurn{};   // Turn each slot counts (0 = empty)
+    std::array<CounterMatrix, TURN_SLOTS> counts{}; // [slot][attacker][defender]
 
-    void RecordAttack(PlayerId attacker, PlayerId defender, int turn, bool success) {
-        entries.push_back({attacker, defender, turn, success});
+    void RecordAttack(PlayerId attacker, PlayerId defender, int turn) {
+        if (attacker >= MAX_PLAYERS || defender >= MAX_PLAYERS || turn <= 0) return;
+
+        // Reusing a slot drops the turn that fell out of memory
+        const int slot = turn % TURN_SLOTS;
+        if (slotTurn[slot] != turn) {
+            slotTurn[slot] = turn;
+            counts[slot] = {};
+        }
+        counts[slot][attacker][defender]++;
     }
 
-    void PruneOldEntries(int currentTurn) {
-        entries.erase(
-            std::remove_if(entries.begin(), entries.end(),
-                [currentTurn](const AttackHistoryEntry& e) {
-                    return currentTurn - e.turnNumber > MEMORY_TURNS;
-                }),
-            entries.end());
+    // Take back the most recent RecordAttack (make/unmake search)
+    void ForgetAttack(PlayerId attacker, PlayerId defender, int turn) {
+        if (attacker >= MAX_PLAYERS || defender >= MAX_PLAYERS || turn <= 0) return;
+
+        const int slot = turn % TURN_SLOTS;
+        if (slotTurn[slot] == turn && counts[slot][attacker][defender] > 0) {
+            counts[slot][attacker][defender]--;
+        }
     }
 
     // Count attacks from one player against another in recent memory
-    int CountAttacksFrom(PlayerId attacker, PlayerId defender, int currentTurn) const {
+    [[nodiscard]] int CountAttacksFrom(PlayerId attacker, PlayerId defender, int currentTurn) const {
+        if (attacker >= MAX_PLAYERS || defender >= MAX_PLAYERS) return 0;
+
         int count = 0;
-        for (const auto& e : entries) {
-            if (e.attacker == attacker && e.defender == defender &&
-                currentTurn - e.turnNumber <= MEMORY_TURNS) {
-                count++;
+        for (int slot = 0; slot < TURN_SLOTS; slot++) {
+            if (slotTurn[slot] != 0 && currentTurn - slotTurn[slot] <= MEMORY_TURNS) {
+                count += counts[slot][attacker][defender];
             }
         }
         return count;
     }
 
     // Check if a player has been peaceful toward another
-    bool HasBeenPeaceful(PlayerId player, PlayerId toward, int currentTurn) const {
+    [[nodiscard]] bool HasBeenPeaceful(PlayerId player, PlayerId toward, int currentTurn) const {
         return CountAttacksFrom(player, toward, currentTurn) == 0;
     }
 };
 
+// Structure-of-arrays copy of the per-territory fields read by hot scans,
+// indexed by TerritoryId. Owner and dice for a whole map fit in a few cache lines.
+struct TerritoryArrays {
+    std::vector<PlayerId> owner;
+    std::vector<uint8_t> diceCount;
+    std::vector<uint16_t> hexCount;
+    std::vector<uint8_t> isBorder; // 1 if any neighbor has a different owner
+
+    [[nodiscard]] size_t Size() const { return owner.size(); }
+};
+
+// Per-player totals kept current by GameState's territory mutators
+struct PlayerAggregates {
+    int territories = 0;
+    int dice = 0;
+    int borderTerritories = 0;      // Owned territories touching another owner
+    int attackCapableTerritories = 0; // Border territories with 2+ dice
+};
+
+// Connected regions of same-owner territories, kept as a union-find forest.
+// Captures merge the captured territory into its new owner's regions in place;
+// only losing a territory (which may split a region) rebuilds that player's sets.
+class TerritoryRegions {
+public:
+    // Recompute every region from scratch
+    void Rebuild(const TerritoryArrays &arrays, const TerritoryGraph &graph);
+
+    // Update after territory `id` changed hands (arrays already hold the new owner)
+    void OnOwnerChanged(TerritoryId id, PlayerId oldOwner,
+                        const TerritoryArrays &arrays, const TerritoryGraph &graph);
+
+    // Update region dice totals after a territory's dice count changed
+    void OnDiceChanged(TerritoryId id, int delta);
+
+    // Representative territory of the region containing `id`
+    [[nodiscard]] TerritoryId RegionOf(TerritoryId id) const;
+
+    [[nodiscard]] int RegionSize(TerritoryId id) const { return _size[RegionOf(id)]; }
+    [[nodiscard]] int RegionDice(TerritoryId id) const { return _dice[RegionOf(id)]; }
+
+    // Size of the player's largest region (O(1), kept current on every change)
+    [[nodiscard]] int LargestRegion(PlayerId player) const {
+        return player < MAX_PLAYERS ? _largest[player] : 0;
+    }
+
+private:
+    std::vector<TerritoryId> _parent;
+    std::vector<uint16_t> _size;  // Valid at region roots
+    std::vector<uint32_t> _dice;  // Valid at region roots
+    std::array<int, MAX_PLAYERS> _largest{};
+
+    void MakeSingleton(TerritoryId id, const TerritoryArrays &arrays);
+    void Union(TerritoryId a, TerritoryId b, PlayerId owner);
+    void UnionWithOwnedNeighbors(TerritoryId id, PlayerId owner,
+                                 const TerritoryArrays &arrays, const TerritoryGraph &graph);
+    void RebuildPlayer(PlayerId player, const TerritoryArrays &arrays, const TerritoryGraph &graph);
+};
+
 // Turn phases
 enum class TurnPhase {
     SelectAttacker, // Human selecting territory to attack from
@@ -144,6 +300,19 @@ enum class TurnPhase {
     GameOver // Victory condition met
 };
 
+// Everything GameState::ApplyAction changed, so Undo can put it back
+struct UndoRecord {
+    TerritoryId attackerId = TERRITORY_NONE;
+    TerritoryId defenderId = TERRITORY_NONE;
+    PlayerId attackerOwner = PLAYER_NONE;
+    PlayerId defenderOwner = PLAYER_NONE;
+    uint8_t attackerDice = 0;
+    uint8_t defenderDice = 0;
+    bool defenderEliminated = false; // Action eliminated the defending player
+    PlayerId previousWinner = PLAYER_NONE;
+    TurnPhase previousPhase = TurnPhase::SelectAttacker;
+};
+
 // Game configuration
 struct GameConfig {
     int gridWidth = 50;  // Hex grid width in columns
@@ -179,7 +348,15 @@ struct GameState {
 
     // Map data
     std::vector<TerritoryData> territories;
-    std::unordered_map<HexCoord, TerritoryId, HexCoordHash> hexToTerritory;
+    TerritoryArrays territoryArrays;
+    TerritoryGraph adjacency;
+    TerritoryRegions regions;
+    std::array<PlayerAggregates, MAX_PLAYERS> playerAggregates{};
+    HexTerritoryMap hexToTerritory;
+
+    // Zobrist hash of every territory's (owner, dice), kept current by the
+    // territory mutators. GetHash() folds in the player to move.
+    uint64_t territoryHash = 0;
 
     // Selection state (for human player)
     TerritoryId selectedTerritory = TERRITORY_NONE;
@@ -218,10 +395,12 @@ struct GameState {
         return nullptr;
     }
 
+    [[nodiscard]] std::span<const TerritoryId> GetNeighbors(TerritoryId id) const {
+        return adjacency.Neighbors(id);
+    }
+
     [[nodiscard]] TerritoryId GetTerritoryAt(const HexCoord &coord) const {
-        auto it = hexToTerritory.find(coord);
-        if (it != hexToTerritory.end()) return it->second;
-        return TERRITORY_NONE;
+        return hexToTerritory.Get(coord);
     }
 
     [[nodiscard]] const PlayerData &GetPlayer(PlayerId id) const {
@@ -230,21 +409,62 @@ struct GameState {
         return nullPlayer;
     }
 
+    [[nodiscard]] PlayerId GetOwner(TerritoryId id) const {
+        if (id < territoryArrays.Size()) return territoryArrays.owner[id];
+        return PLAYER_NONE;
+    }
+
+    [[nodiscard]] int GetDice(TerritoryId id) const {
+        if (id < territoryArrays.Size()) return territoryArrays.diceCount[id];
+        return 0;
+    }
+
+    // Position hash: territory owners and dice plus the player to move. Equal
+    // positions reached through different attack orders hash the same, so it
+    // keys transposition tables and doubles as a desync checksum.
+    [[nodiscard]] uint64_t GetHash() const;
+
+    // Mutators that keep TerritoryData, territoryArrays, regions,
+    // playerAggregates and territoryHash in sync
+    void SetTerritoryOwner(TerritoryId id, PlayerId owner);
+    void SetTerritoryDice(TerritoryId id, uint8_t diceCount);
+
+    // Rebuild territoryArrays, regions, playerAggregates and territoryHash from territories
+    // (after map generation or ID remapping)
+    void RebuildTerritoryArrays();
+
+    // Make/unmake for look-ahead search. ApplyAction plays one attack with a known
+    // outcome: moves dice/ownership, records it in attackHistory and updates
+    // elimination and victory. Undo reverses it exactly; records must be undone
+    // in reverse order of application.
+    UndoRecord ApplyAction(const CombatAction &action, bool attackerWins);
+    void Undo(const UndoRecord &record);
+
+    [[nodiscard]] const PlayerAggregates &GetAggregates(PlayerId player) const {
+        static PlayerAggregates empty;
+        if (player < MAX_PLAYERS) return playerAggregates[player];
+        return empty;
+    }
+
     [[nodiscard]] int CountTerritoriesOwned(PlayerId player) const {
-        int count = 0;
-        for (const auto &t: territories) {
-            if (t.owner == player) count++;
-        }
-        return count;
+        return GetAggregates(player).territories;
     }
 
     [[nodiscard]] int CountDiceOwned(PlayerId player) const {
-        int count = 0;
-        for (const auto &t: territories) {
-            if (t.owner == player) count += t.diceCount;
-        }
-        return count;
+        return GetAggregates(player).dice;
     }
+
+    // Dice a player receives at the end of their turn: one per territory in
+    // their largest connected region
+    [[nodiscard]] int GetReinforcements(PlayerId player) const {
+        return regions.LargestRegion(player);
+    }
+
+private:
+    [[nodiscard]] bool ComputeIsBorder(TerritoryId id) const;
+
+    // Add (sign = +1) or remove (sign = -1) one territory's contribution to its owner's aggregates
+    void AccumulateAggregates(TerritoryId id, int sign);
 };
 
 // UI state (separate from game state for clean separation)
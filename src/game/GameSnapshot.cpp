@@ -0,0 +1,66 @@
+//
+// GameSnapshot.cpp - Game state snapshot implementation
+//
+
+#include "GameSnapshot.h"
+#include <cstring>
+
+void GameSnapshot::Capture(const GameState &state) {
+    const TerritoryArrays &arrays = state.territoryArrays;
+    const size_t territoryCount = arrays.Size();
+
+    _header.territoryCount = static_cast<uint32_t>(territoryCount);
+    _header.turnNumber = state.turnNumber;
+    _header.activePlayerCount = state.activePlayerCount;
+    _header.currentPlayer = state.currentPlayer;
+    _header.winner = state.winner;
+    _header.phase = state.phase;
+    _header.attackHistory = state.attackHistory;
+    _header.eliminatedMask = 0;
+    for (int p = 0; p < MAX_PLAYERS; p++) {
+        if (state.players[p].isEliminated) _header.eliminatedMask |= static_cast<uint8_t>(1 << p);
+    }
+
+    _data.resize(territoryCount * 2);
+
+    uint8_t *out = _data.data();
+    std::memcpy(out, arrays.owner.data(), territoryCount);
+    std::memcpy(out + territoryCount, arrays.diceCount.data(), territoryCount);
+}
+
+void GameSnapshot::Restore(GameState &state) const {
+    const size_t territoryCount = _header.territoryCount;
+    if (territoryCount != state.territories.size()) return;
+
+    const PlayerId *owners = _data.data();
+    const uint8_t *dice = _data.data() + territoryCount;
+    for (size_t i = 0; i < territoryCount; i++) {
+        state.territories[i].owner = owners[i];
+        state.territories[i].diceCount = dice[i];
+    }
+
+    state.attackHistory = _header.attackHistory;
+
+    state.turnNumber = _header.turnNumber;
+    state.activePlayerCount = _header.activePlayerCount;
+    state.currentPlayer = _header.currentPlayer;
+    state.winner = _header.winner;
+    state.phase = _header.phase;
+    for (int p = 0; p < MAX_PLAYERS; p++) {
+        state.players[p].isEliminated = (_header.eliminatedMask >> p) & 1;
+    }
+
+    state.selectedTerritory = TERRITORY_NONE;
+    state.validTargets.clear();
+    state.mapNeedsRefresh = true;
+
+    state.RebuildTerritoryArrays();
+}
+
+std::span<const PlayerId> GameSnapshot::GetOwners() const {
+    return {_data.data(), _header.territoryCount};
+}
+
+std::span<const uint8_t> GameSnapshot::GetDice() const {
+    return {_data.data() + _header.territoryCount, _header.territoryCount};
+}
@@ -0,0 +1,56 @@
+//
+// GameSnapshot.h - Compact copy of the game-relevant part of GameState
+//
+
+#ifndef ATLAS_GAMESNAPSHOT_H
+#define ATLAS_GAMESNAPSHOT_H
+
+#include "GameData.h"
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Fixed-size part of a snapshot
+struct GameSnapshotHeader {
+    uint32_t territoryCount = 0;
+    int32_t turnNumber = 1;
+    int32_t activePlayerCount = 0;
+    PlayerId currentPlayer = 0;
+    PlayerId winner = PLAYER_NONE;
+    TurnPhase phase = TurnPhase::SelectAttacker;
+    uint8_t eliminatedMask = 0; // Bit p set = player p eliminated
+    AttackHistory attackHistory;
+};
+
+static_assert(std::is_trivially_copyable_v<GameSnapshotHeader>);
+
+// Owners, dice, turn state and attack history, without the static map (hexes,
+// adjacency), player names or UI selection. The variable part is a single
+// byte buffer, so copying a snapshot is one memcpy of O(territories) bytes,
+// and Capture() reuses the existing buffer when it is large enough.
+class GameSnapshot {
+public:
+    GameSnapshot() = default;
+
+    // Capture state into this snapshot
+    void Capture(const GameState &state);
+
+    // Write the snapshot back into a state generated from the same map.
+    // Derived data (territoryArrays, regions, aggregates) is rebuilt and any
+    // UI selection is cleared.
+    void Restore(GameState &state) const;
+
+    [[nodiscard]] const GameSnapshotHeader &GetHeader() const { return _header; }
+    [[nodiscard]] std::span<const PlayerId> GetOwners() const;
+    [[nodiscard]] std::span<const uint8_t> GetDice() const;
+
+    // Raw bytes of the variable part (owners, dice)
+    [[nodiscard]] std::span<const uint8_t> GetData() const { return _data; }
+    [[nodiscard]] size_t GetByteSize() const { return sizeof(_header) + _data.size(); }
+
+private:
+    GameSnapshotHeader _header;
+    std::vector<uint8_t> _data; // owner[n] | dice[n]
+};
+
+#endif // ATLAS_GAMESNAPSHOT_H
@@ -0,0 +1,455 @@
+//
+// MCTSController.cpp - Monte Carlo tree search AI implementation
+//
+
+#include "MCTSController.h"
+#include "GameController.h"
+#include "DiceOdds.h"
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "../Profiling.h"
+
+using SearchClock = std::chrono::steady_clock;
+
+// One thread's search: a private state, its own tree, and a greedy
+// AIController bound to that state as rollout policy. Every playout applies
+// moves with GameState::ApplyAction and unwinds them before the next one.
+// Leaf values (EvaluateLeafPosition) are cached by position hash, since
+// playouts that capture the same territories in a different order end on the
+// same position.
+class MCTSController::SearchWorker
+{
+public:
+    // `state` holds the root position and is only borrowed for the search
+    SearchWorker(GameState& state, PlayerId player, const MCTSConfig& config, RandomEngine rng)
+        : _state(state),
+          _player(player),
+          _config(config),
+          _policy(&_state, static_cast<unsigned int>(rng() >> 32) | 1u),
+          _rng(rng),
+          _table(static_cast<size_t>(std::max(1, config.transpositionEntries)))
+    {
+    }
+
+    std::vector<RootMoveStats> Run(SearchClock::time_point deadline, int playoutLimit)
+    {
+        ZoneScoped;
+        _nodes.emplace_back();
+
+        while (playoutLimit <= 0 || _playouts < playoutLimit)
+        {
+            if (_config.timeBudgetMs > 0 && SearchClock::now() >= deadline) break;
+            Playout();
+            _playouts++;
+        }
+
+        std::vector<RootMoveStats> stats;
+        for (const SearchEdge& edge : _nodes[0].edges)
+        {
+            stats.push_back({edge.from, edge.to, edge.visits, edge.totalValue});
+        }
+        return stats;
+    }
+
+    [[nodiscard]] int GetPlayoutCount() const { return _playouts; }
+
+private:
+    struct SearchEdge
+    {
+        TerritoryId from = TERRITORY_NONE; // TERRITORY_NONE = end turn
+        TerritoryId to = TERRITORY_NONE;
+        int visits = 0;
+        double totalValue = 0.0;
+        int children[2] = {-1, -1}; // Node index after a capture / a repelled attack
+    };
+
+    struct SearchNode
+    {
+        std::vector<SearchEdge> edges; // Attacks by descending heuristic score, then end turn
+        int visits = 0;
+        bool expanded = false;
+    };
+
+    GameState& _state;
+    PlayerId _player;
+    const MCTSConfig& _config;
+    AIController _policy;
+    RandomEngine _rng;
+    TranspositionTable _table;
+    std::vector<SearchNode> _nodes;
+    std::vector<UndoRecord> _undo;
+    int _playouts = 0;
+
+    void Playout()
+    {
+        std::vector<std::pair<int, int>> path; // (node, edge) pairs from the root
+        int node = 0;
+        bool turnOver = false;
+
+        while (true)
+        {
+            if (!_nodes[node].expanded)
+            {
+                Expand(node);
+            }
+
+            int edgeIndex = SelectEdge(node);
+            path.emplace_back(node, edgeIndex);
+
+            SearchEdge& edge = _nodes[node].edges[edgeIndex];
+            if (edge.from == TERRITORY_NONE)
+            {
+                turnOver = true;
+                break;
+            }
+
+            bool captured = Attack(edge.from, edge.to);
+            if (_state.IsGameOver())
+            {
+                turnOver = true;
+                break;
+            }
+
+            int child = edge.children[captured ? 0 : 1];
+            if (child < 0)
+            {
+                // First visit to this outcome: add a node and roll out from here
+                child = static_cast<int>(_nodes.size());
+                _nodes[node].edges[edgeIndex].children[captured ? 0 : 1] = child;
+                _nodes.emplace_back();
+                break;
+            }
+            node = child;
+        }
+
+        if (!turnOver)
+        {
+            RolloutTurn(_player);
+        }
+        if (_config.simulateOpponents)
+        {
+            for (int offset = 1; offset < _state.config.playerCount && !_state.IsGameOver(); offset++)
+            {
+                PlayerId opponent = static_cast<PlayerId>((_player + offset) % _state.config.playerCount);
+                if (!_state.players[opponent].isEliminated)
+                {
+                    RolloutTurn(opponent);
+                }
+            }
+        }
+
+        double value = EvaluateLeaf();
+        for (auto [pathNode, pathEdge] : path)
+        {
+            SearchEdge& edge = _nodes[pathNode].edges[pathEdge];
+            edge.visits++;
+            edge.totalValue += value;
+            _nodes[pathNode].visits++;
+        }
+
+        while (!_undo.empty())
+        {
+            _state.Undo(_undo.back());
+            _undo.pop_back();
+        }
+    }
+
+    double EvaluateLeaf()
+    {
+        if (_config.transpositionEntries <= 0)
+        {
+            return EvaluateLeafPosition(_state, _player, _config);
+        }
+
+        const uint64_t hash = _state.GetHash();
+        if (std::optional<double> cached = _table.Probe(hash))
+        {
+            return *cached;
+        }
+
+        double value = EvaluateLeafPosition(_state, _player, _config);
+        _table.Store(hash, value);
+        return value;
+    }
+
+    void Expand(int node)
+    {
+        std::vector<AttackEvaluation> attacks = _policy.EvaluateAttacks(_player);
+        std::erase_if(attacks, [this](const AttackEvaluation& attack) {
+            return attack.winProbability < _config.minWinProbability;
+        });
+        std::sort(attacks.begin(), attacks.end(),
+            [](const AttackEvaluation& a, const AttackEvaluation& b) {
+                return a.score > b.score;
+            });
+        if (static_cast<int>(attacks.size()) > _config.maxCandidates)
+        {
+            attacks.resize(_config.maxCandidates);
+        }
+
+        std::vector<SearchEdge>& edges = _nodes[node].edges;
+        edges.reserve(attacks.size() + 1);
+        for (const AttackEvaluation& attack : attacks)
+        {
+            SearchEdge edge;
+            edge.from = attack.from;
+            edge.to = attack.to;
+            edges.push_back(edge);
+        }
+        edges.emplace_back(); // End turn
+        _nodes[node].expanded = true;
+    }
+
+    int SelectEdge(int node) const
+    {
+        const SearchNode& current = _nodes[node];
+
+        // Try every move once, in heuristic order, before trusting the statistics
+        for (size_t i = 0; i < current.edges.size(); i++)
+        {
+            if (current.edges[i].visits == 0) return static_cast<int>(i);
+        }
+
+        double logVisits = std::log(static_cast<double>(current.visits));
+        int best = 0;
+        double bestScore = -1.0;
+        for (size_t i = 0; i < current.edges.size(); i++)
+        {
+            const SearchEdge& edge = current.edges[i];
+            double score = edge.totalValue / edge.visits +
+                           _config.exploration * std::sqrt(logVisits / edge.visits);
+            if (score > bestScore)
+            {
+                bestScore = score;
+                best = static_cast<int>(i);
+            }
+        }
+        return best;
+    }
+
+    // Apply an attack with a sampled outcome; returns true on capture
+    bool Attack(TerritoryId from, TerritoryId to)
+    {
+        float winProbability = DiceOdds::WinProbability(_state.GetDice(from), _state.GetDice(to));
+        bool captured = std::bernoulli_distribution(winProbability)(_rng);
+
+        CombatAction action;
+        action.attackerId = from;
+        action.defenderId = to;
+        action.attackerPlayer = _state.GetOwner(from);
+        _undo.push_back(_state.ApplyAction(action, captured));
+        return captured;
+    }
+
+    void RolloutTurn(PlayerId player)
+    {
+        for (int i = 0; i < _config.maxRolloutAttacks && !_state.IsGameOver(); i++)
+        {
+            std::optional<AttackEvaluation> attack = _policy.ChooseAttack(player);
+            if (!attack) break;
+            Attack(attack->from, attack->to);
+        }
+    }
+};
+
+bool MCTSController::IsSameMap(const GameState& a, const GameState& b)
+{
+    return a.config.playerCount == b.config.playerCount &&
+           a.adjacency.offsets == b.adjacency.offsets &&
+           a.adjacency.neighbors == b.adjacency.neighbors &&
+           a.territoryArrays.hexCount == b.territoryArrays.hexCount;
+}
+
+double MCTSController::EvaluateLeafPosition(const GameState& state, PlayerId player, const MCTSConfig& config)
+{
+    if (state.winner == player) return 1.0;
+
+    const PlayerAggregates& own = state.GetAggregates(player);
+    if (own.territories == 0) return 0.0;
+
+    const TerritoryArrays& arrays = state.territoryArrays;
+    const double territoryCount = static_cast<double>(arrays.Size());
+
+    int totalDice = 0;
+    int leaderIncome = 0;
+    for (int p = 0; p < state.config.playerCount; p++)
+    {
+        totalDice += state.playerAggregates[p].dice;
+        if (p != player)
+        {
+            leaderIncome = std::max(leaderIncome, state.GetReinforcements(static_cast<PlayerId>(p)));
+        }
+    }
+
+    // End-of-turn reinforcements, capped by the room left on our territories
+    int capacity = own.territories * MAX_DICE_PER_TERRITORY - own.dice;
+    int reinforcements = std::min(state.GetReinforcements(player), capacity);
+
+    // Our largest region, ties going to the one holding the lowest ID
+    const int largestSize = state.regions.LargestRegion(player);
+    TerritoryId largestRoot = TERRITORY_NONE;
+    for (size_t i = 0; i < arrays.Size() && largestRoot == TERRITORY_NONE; i++)
+    {
+        const TerritoryId id = static_cast<TerritoryId>(i);
+        if (arrays.owner[i] == player && state.regions.RegionSize(id) == largestSize)
+        {
+            largestRoot = state.regions.RegionOf(id);
+        }
+    }
+
+    // Count each territory, and its dice, only as far as it is expected to
+    // survive the next round against its strongest attacker
+    double keptTerritories = 0.0;
+    double keptLargest = 0.0;
+    double lostDice = 0.0;
+    for (size_t i = 0; i < arrays.Size(); i++)
+    {
+        if (arrays.owner[i] != player) continue;
+
+        const TerritoryId id = static_cast<TerritoryId>(i);
+        float worst = 0.0f;
+        if (arrays.isBorder[i])
+        {
+            for (TerritoryId neighborId : state.GetNeighbors(id))
+            {
+                if (arrays.owner[neighborId] != player && arrays.diceCount[neighborId] >= 2)
+                {
+                    worst = std::max(worst, DiceOdds::WinProbability(
+                        arrays.diceCount[neighborId], arrays.diceCount[i]));
+                }
+            }
+        }
+
+        const double risk = config.captureRiskWeight * worst;
+        keptTerritories += 1.0 - risk;
+        lostDice += risk * arrays.diceCount[i];
+        if (state.regions.RegionOf(id) == largestRoot)
+        {
+            keptLargest += 1.0 - risk;
+        }
+    }
+
+    double value = 0.5 * keptLargest / territoryCount +
+                   0.2 * keptTerritories / territoryCount +
+                   0.3 * (own.dice - lostDice + reinforcements) / std::max(1, totalDice + reinforcements) -
+                   config.leaderWeight * leaderIncome / territoryCount;
+    return std::clamp(value, 0.0, 1.0);
+}
+
+MCTSController::MCTSController(GameController* controller, const MCTSConfig& config, unsigned int seed)
+    : AIController(controller, seed),
+      _config(config),
+      _pool(config.threadCount)
+{
+    if (_config.timeBudgetMs <= 0 && _config.playoutBudget <= 0)
+    {
+        _config.playoutBudget = 1000;
+    }
+    _config.maxCandidates = std::max(1, _config.maxCandidates);
+}
+
+std::optional<CombatAction> MCTSController::DecideAction(const GameState& view, PlayerId player)
+{
+    ZoneScoped;
+    if (player >= MAX_PLAYERS || !(_config.searchPlayers & (1u << player)))
+    {
+        return AIController::DecideAction(view, player);
+    }
+
+    // Nothing to search without a border territory that can attack
+    if (view.GetAggregates(player).attackCapableTerritories == 0)
+    {
+        return std::nullopt;
+    }
+
+    const int workerCount = _pool.GetThreadCount();
+    const int playoutsPerWorker = _config.playoutBudget > 0
+        ? std::max(1, (_config.playoutBudget + workerCount - 1) / workerCount)
+        : 0;
+    const SearchClock::time_point deadline =
+        SearchClock::now() + std::chrono::milliseconds(_config.timeBudgetMs);
+
+    // Workers keep their states between decisions and only take the owners,
+    // dice and turn state from the snapshot; a full copy is needed only when
+    // the map itself changed (first decision or a new game)
+    _rootSnapshot.Capture(view);
+    _workerStates.resize(workerCount);
+
+    std::vector<std::future<std::pair<std::vector<RootMoveStats>, int>>> results;
+    results.reserve(workerCount);
+    // Each worker gets its own jump-ahead stream of one engine seeded per decision
+    RandomEngine stream(_rng());
+    for (int i = 0; i < workerCount; i++)
+    {
+        RandomEngine workerRng = stream;
+        stream.Jump();
+        GameState* state = &_workerStates[i];
+        results.push_back(_pool.Submit([this, state, &view, player, workerRng, deadline, playoutsPerWorker]() {
+            if (IsSameMap(*state, view))
+            {
+                _rootSnapshot.Restore(*state);
+            }
+            else
+            {
+                *state = view;
+            }
+
+            SearchWorker worker(*state, player, _config, workerRng);
+            std::vector<RootMoveStats> stats = worker.Run(deadline, playoutsPerWorker);
+            return std::make_pair(std::move(stats), worker.GetPlayoutCount());
+        }));
+    }
+
+    // Sum root statistics across the independent trees
+    std::vector<RootMoveStats> merged;
+    _lastPlayoutCount = 0;
+    for (auto& result : results)
+    {
+        auto [stats, playouts] = result.get();
+        _lastPlayoutCount += playouts;
+        for (const RootMoveStats& move : stats)
+        {
+            auto it = std::find_if(merged.begin(), merged.end(), [&move](const RootMoveStats& m) {
+                return m.from == move.from && m.to == move.to;
+            });
+            if (it == merged.end())
+            {
+                merged.push_back(move);
+            }
+            else
+            {
+                it->visits += move.visits;
+                it->totalValue += move.totalValue;
+            }
+        }
+    }
+
+    // Most visited move wins; mean value breaks ties
+    const RootMoveStats* best = nullptr;
+    for (const RootMoveStats& move : merged)
+    {
+        if (move.visits == 0) continue;
+        if (!best || move.visits > best->visits ||
+            (move.visits == best->visits &&
+             move.totalValue / move.visits > best->totalValue / best->visits))
+        {
+            best = &move;
+        }
+    }
+
+    if (!best || best->from == TERRITORY_NONE)
+    {
+        return std::nullopt;  // Ending the turn scored best
+    }
+
+    CombatAction action;
+    action.attackerId = best->from;
+    action.defenderId = best->to;
+    action.attackerPlayer = player;
+    action.attackerDice = static_cast<uint8_t>(view.GetDice(best->from));
+    action.defenderDice = static_cast<uint8_t>(view.GetDice(best->to));
+    return action;
+}
@@ -0,0 +1,76 @@
+//
+// MCTSController.h - Monte Carlo tree search AI for computer players
+//
+
+#ifndef ATLAS_MCTSCONTROLLER_H
+#define ATLAS_MCTSCONTROLLER_H
+
+#include "AIController.h"
+#include "GameSnapshot.h"
+#include "../ThreadPool.h"
+
+struct MCTSConfig
+{
+    int timeBudgetMs = 50;        // Wall-clock budget per decision (0 = no limit)
+    int playoutBudget = 0;        // Playouts per decision across all threads (0 = no limit)
+    int threadCount = 0;          // Search threads (0 = one per hardware thread)
+    int maxCandidates = 8;        // Attacks expanded per tree node, best heuristic score first
+    float minWinProbability = 0.4f; // Attacks below this are never expanded (the greedy threshold)
+    int maxRolloutAttacks = 64;   // Safety cap on attacks per simulated turn
+    bool simulateOpponents = false; // Also play one greedy turn per opponent before evaluating
+                                    // (much slower; the evaluation already scores threats)
+    float exploration = 0.7f;     // UCT exploration constant
+    float captureRiskWeight = 0.3f; // Leaf values discount each territory by this times its chance of falling
+    float leaderWeight = 0.2f;    // Leaf values lose this times the strongest opponent's income share
+    int transpositionEntries = 1 << 13; // Cached leaf values per search thread (0 = evaluate every time)
+    uint8_t searchPlayers = 0xFF; // Bitmask of seats that search; other seats play greedily
+};
+
+// Searches the current player's attack sequence for this turn. Every thread
+// builds its own tree on a private state restored from a snapshot of the
+// position (root parallelization) and the root visit counts are summed to pick
+// the move. Leaves are rolled out with the greedy AIController policy and
+// scored by EvaluateLeafPosition.
+class MCTSController : public AIController
+{
+public:
+    MCTSController(GameController* controller, const MCTSConfig& config = {}, unsigned int seed = 0);
+
+    std::optional<CombatAction> DecideAction(const GameState& view, PlayerId player) override;
+
+    [[nodiscard]] const MCTSConfig& GetConfig() const { return _config; }
+
+    // Playouts run for the most recent decision (all threads)
+    [[nodiscard]] int GetLastPlayoutCount() const { return _lastPlayoutCount; }
+
+    // EvaluatePosition's terms with every territory discounted by its chance of
+    // falling next round, minus the strongest opponent's income. Playouts stop
+    // at the end of our turn, so this is what keeps the search from spreading
+    // thin across borders it can't hold.
+    [[nodiscard]] static double EvaluateLeafPosition(const GameState& state, PlayerId player,
+                                                     const MCTSConfig& config);
+
+private:
+    class SearchWorker;
+
+    // Visit statistics for one root move; from == TERRITORY_NONE means "end turn"
+    struct RootMoveStats
+    {
+        TerritoryId from = TERRITORY_NONE;
+        TerritoryId to = TERRITORY_NONE;
+        int visits = 0;
+        double totalValue = 0.0;
+    };
+
+    // True when both states were generated from the same map, so a snapshot
+    // of one can be restored into the other
+    static bool IsSameMap(const GameState& a, const GameState& b);
+
+    MCTSConfig _config;
+    ThreadPool _pool;
+    GameSnapshot _rootSnapshot;          // Position being searched
+    std::vector<GameState> _workerStates; // One per search thread, reused across decisions
+    int _lastPlayoutCount = 0;
+};
+
+#endif // ATLAS_MCTSCONTROLLER_H
@@ -0,0 +1,31 @@
+//
+// TranspositionTable.cpp - Bounded position value cache implementation
+//
+
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <bit>
+
+TranspositionTable::TranspositionTable(size_t capacity)
+{
+    _entries.resize(std::bit_ceil(capacity == 0 ? size_t{1} : capacity));
+    _mask = _entries.size() - 1;
+}
+
+std::optional<double> TranspositionTable::Probe(uint64_t hash) const
+{
+    const Entry& entry = _entries[hash & _mask];
+    if (hash == 0 || entry.hash != hash) return std::nullopt;
+    return entry.value;
+}
+
+void TranspositionTable::Store(uint64_t hash, double value)
+{
+    if (hash == 0) return;
+    _entries[hash & _mask] = {hash, value};
+}
+
+void TranspositionTable::Clear()
+{
+    std::fill(_entries.begin(), _entries.end(), Entry{});
+}
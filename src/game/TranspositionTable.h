@@ -0,0 +1,39 @@
+//
+// TranspositionTable.h - Bounded cache of position values keyed by Zobrist hash
+//
+
+#ifndef ATLAS_TRANSPOSITIONTABLE_H
+#define ATLAS_TRANSPOSITIONTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Fixed number of slots indexed by the low bits of the hash; a store always
+// replaces what was in its slot. Memory stays at capacity * 16 bytes however
+// long a search runs. Not thread-safe: give each search thread its own table.
+class TranspositionTable
+{
+public:
+    // Capacity is rounded up to a power of two (at least 1)
+    explicit TranspositionTable(size_t capacity = 1 << 14);
+
+    [[nodiscard]] std::optional<double> Probe(uint64_t hash) const;
+    void Store(uint64_t hash, double value);
+    void Clear();
+
+    [[nodiscard]] size_t GetCapacity() const { return _entries.size(); }
+
+private:
+    struct Entry
+    {
+        uint64_t hash = 0; // 0 = empty
+        double value = 0.0;
+    };
+
+    std::vector<Entry> _entries;
+    size_t _mask = 0;
+};
+
+#endif // ATLAS_TRANSPOSITIONTABLE_H
@@ -0,0 +1,148 @@
+//
+// TurnPlanner.cpp - Beam search over whole-turn attack sequences
+//
+
+#include "TurnPlanner.h"
+#include "AIController.h"
+#include <algorithm>
+
+#include "../Profiling.h"
+
+TurnPlanner::TurnPlanner(const TurnPlannerConfig& config)
+    : _config(config),
+      _table(static_cast<size_t>(std::max(1, config.transpositionEntries)))
+{
+    _config.beamWidth = std::max(1, _config.beamWidth);
+    _config.candidatesPerNode = std::max(1, _config.candidatesPerNode);
+}
+
+std::vector<CombatAction> TurnPlanner::PlanTurn(const GameState& state, PlayerId player)
+{
+    ZoneScoped;
+    // Plans are explored on a private copy with make/unmake
+    GameState work = state;
+    AIController scorer(&work, 1);
+    std::vector<UndoRecord> undo;
+
+    // Cached values are only valid for the player they were scored for
+    if (_tablePlayer != player)
+    {
+        _table.Clear();
+        _tablePlayer = player;
+    }
+
+    PlanNode best;
+    best.score = Evaluate(work, player);
+    best.hash = work.GetHash();
+
+    std::vector<PlanNode> beam{best};
+    std::vector<PlanNode> next;
+
+    for (int depth = 0; depth < _config.maxPlanLength && !beam.empty(); depth++)
+    {
+        next.clear();
+
+        for (const PlanNode& node : beam)
+        {
+            // Replay the line where every planned attack captured
+            for (const CombatAction& action : node.actions)
+            {
+                undo.push_back(work.ApplyAction(action, true));
+            }
+
+            if (!work.IsGameOver())
+            {
+                std::vector<AttackEvaluation> attacks = scorer.EvaluateAttacks(player);
+                std::sort(attacks.begin(), attacks.end(),
+                    [](const AttackEvaluation& a, const AttackEvaluation& b) {
+                        return a.score > b.score;
+                    });
+
+                int tried = 0;
+                for (const AttackEvaluation& attack : attacks)
+                {
+                    if (tried >= _config.candidatesPerNode) break;
+                    if (attack.winProbability < _config.minWinProbability) continue;
+                    tried++;
+
+                    CombatAction action;
+                    action.attackerId = attack.from;
+                    action.defenderId = attack.to;
+                    action.attackerPlayer = player;
+                    action.attackerDice = static_cast<uint8_t>(attack.attackerDice);
+                    action.defenderDice = static_cast<uint8_t>(attack.defenderDice);
+
+                    UndoRecord record = work.ApplyAction(action, false);
+                    double repelledValue = Evaluate(work, player);
+                    work.Undo(record);
+
+                    record = work.ApplyAction(action, true);
+                    double capturedValue = Evaluate(work, player);
+                    const uint64_t capturedHash = work.GetHash();
+                    work.Undo(record);
+
+                    const double p = attack.winProbability;
+                    PlanNode child;
+                    child.actions = node.actions;
+                    child.actions.push_back(action);
+                    child.successProbability = node.successProbability * p;
+                    child.failureValue = node.failureValue + node.successProbability * (1.0 - p) * repelledValue;
+                    child.score = child.failureValue + child.successProbability * capturedValue;
+                    child.hash = capturedHash;
+                    next.push_back(std::move(child));
+                }
+            }
+
+            while (!undo.empty())
+            {
+                work.Undo(undo.back());
+                undo.pop_back();
+            }
+        }
+
+        // Keep the best partial plans for the next depth. Plans reaching the
+        // same position in a different order are transpositions; only the
+        // best scoring one is kept.
+        std::sort(next.begin(), next.end(),
+            [](const PlanNode& a, const PlanNode& b) { return a.score > b.score; });
+        size_t kept = 0;
+        for (size_t i = 0; i < next.size() && static_cast<int>(kept) < _config.beamWidth; i++)
+        {
+            const uint64_t hash = next[i].hash;
+            bool transposition = std::any_of(next.begin(), next.begin() + kept,
+                [hash](const PlanNode& node) { return node.hash == hash; });
+            if (transposition) continue;
+
+            if (i != kept) next[kept] = std::move(next[i]);
+            kept++;
+        }
+        next.resize(kept);
+
+        if (!next.empty() && next.front().score > best.score)
+        {
+            best = next.front();
+        }
+        std::swap(beam, next);
+    }
+
+    _lastPlanValue = best.score;
+    return best.actions;
+}
+
+double TurnPlanner::Evaluate(const GameState& state, PlayerId player)
+{
+    if (_config.transpositionEntries <= 0)
+    {
+        return AIController::EvaluatePosition(state, player);
+    }
+
+    const uint64_t hash = state.GetHash();
+    if (std::optional<double> cached = _table.Probe(hash))
+    {
+        return *cached;
+    }
+
+    double value = AIController::EvaluatePosition(state, player);
+    _table.Store(hash, value);
+    return value;
+}
@@ -0,0 +1,62 @@
+//
+// TurnPlanner.h - Beam search over whole-turn attack sequences
+//
+
+#ifndef ATLAS_TURNPLANNER_H
+#define ATLAS_TURNPLANNER_H
+
+#include "GameData.h"
+#include "TranspositionTable.h"
+#include <vector>
+
+struct TurnPlannerConfig
+{
+    int beamWidth = 4;          // Partial plans kept per depth
+    int candidatesPerNode = 4;  // Attacks tried from each partial plan, best heuristic score first
+    int maxPlanLength = 12;     // Longest attack sequence considered
+    float minWinProbability = 0.35f; // Attacks below this are never planned
+    uint8_t plannerPlayers = 0xFF;   // Bitmask of seats that plan; other seats play greedily
+    int transpositionEntries = 1 << 14; // Cached position values (0 = evaluate every time)
+};
+
+// Plans a player's whole turn as a sequence of attacks. Each plan is scored by
+// its expected end-of-turn position: every step either captures (and the plan
+// continues) or is repelled (and the turn stops there), weighted by the exact
+// dice odds and evaluated with AIController::EvaluatePosition, which counts the
+// end-of-turn reinforcements.
+class TurnPlanner
+{
+public:
+    explicit TurnPlanner(const TurnPlannerConfig& config = {});
+
+    // Best attack sequence for `player` from `state`; empty means end the turn
+    std::vector<CombatAction> PlanTurn(const GameState& state, PlayerId player);
+
+    [[nodiscard]] const TurnPlannerConfig& GetConfig() const { return _config; }
+
+    // Expected value of the most recent plan (in EvaluatePosition units)
+    [[nodiscard]] double GetLastPlanValue() const { return _lastPlanValue; }
+
+private:
+    struct PlanNode
+    {
+        std::vector<CombatAction> actions;
+        double successProbability = 1.0; // Chance every attack so far captured
+        double failureValue = 0.0;       // Value summed over the turn ending early
+        double score = 0.0;              // failureValue + successProbability * value now
+        uint64_t hash = 0;               // Position after every attack captured
+    };
+
+    TurnPlannerConfig _config;
+    double _lastPlanValue = 0.0;
+
+    // Position values for _tablePlayer; different attack orders within a turn
+    // keep reaching the same positions
+    TranspositionTable _table;
+    PlayerId _tablePlayer = PLAYER_NONE;
+
+    // EvaluatePosition through the transposition table
+    double Evaluate(const GameState& state, PlayerId player);
+};
+
+#endif // ATLAS_TURNPLANNER_H
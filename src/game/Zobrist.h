@@ -0,0 +1,37 @@
+//
+// Zobrist.h - Position hash keys for territories and the player to move
+//
+
+#ifndef ATLAS_ZOBRIST_H
+#define ATLAS_ZOBRIST_H
+
+#include "GameData.h"
+#include <algorithm>
+#include <cstdint>
+
+// Keys are derived from their index with a SplitMix64 finalizer rather than
+// stored, so any map size works and every build and machine agrees on them
+// (hashes can be compared across replays and networked peers).
+namespace Zobrist {
+    constexpr uint64_t Mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // Key for a territory held by `owner` (PLAYER_NONE included) with `dice` dice
+    constexpr uint64_t TerritoryKey(TerritoryId id, PlayerId owner, int dice) {
+        const uint64_t ownerSlot = std::min<int>(owner, MAX_PLAYERS);
+        const uint64_t diceSlot = std::clamp(dice, 0, MAX_DICE_PER_TERRITORY);
+        return Mix((static_cast<uint64_t>(id) * (MAX_PLAYERS + 1) + ownerSlot) *
+                   (MAX_DICE_PER_TERRITORY + 1) + diceSlot);
+    }
+
+    // Key for the player to move (indices far above any territory key's)
+    constexpr uint64_t PlayerKey(PlayerId player) {
+        return Mix(~static_cast<uint64_t>(player));
+    }
+}
+
+#endif // ATLAS_ZOBRIST_H
@@ -117,6 +117,19 @@ struct HexCoordHash
     }
 };
 
+// Offset (column, row) layout of the rectangular maps built by HexGrid:
+// odd rows are shifted right by half a hex, so column = q + r / 2
+namespace HexOffset
+{
+    [[nodiscard]] constexpr int Row(const HexCoord& coord) { return coord.r; }
+    [[nodiscard]] constexpr int Column(const HexCoord& coord) { return coord.q + coord.r / 2; }
+
+    [[nodiscard]] constexpr HexCoord ToAxial(int column, int row)
+    {
+        return HexCoord(column - row / 2, row);
+    }
+}
+
 // Hex geometry constants for pointy-top orientation
 namespace HexGeometry
 {
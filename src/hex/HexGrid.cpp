@@ -8,7 +8,7 @@
 #include <limits>
 #include <optional>
 
-#include <tracy/Tracy.hpp>
+#include "../Profiling.h"
 
 HexGrid::HexGrid(const HexGridConfig& config)
     : _config(config)
@@ -20,7 +20,8 @@ void HexGrid::GenerateRectangularGrid()
 {
     ZoneScoped;
     _coords.clear();
-    _validCoords.clear();
+    const size_t cellCount = static_cast<size_t>(std::max(0, _config.width)) * std::max(0, _config.height);
+    _validBits.assign((cellCount + 63) / 64, 0);
 
     // Create noise generator if filtering is enabled
     std::optional<siv::PerlinNoise> noise;
@@ -33,16 +34,11 @@ void HexGrid::GenerateRectangularGrid()
     // For pointy-top hexes, odd rows are shifted right by half a hex width
     for (int row = 0; row < _config.height; row++)
     {
-        // Calculate q offset for this row to create rectangular shape
-        // Odd rows need adjustment due to the staggered hex layout
-        int qOffset = row / 2;
-
         for (int col = 0; col < _config.width; col++)
         {
             // Convert offset coordinates to axial coordinates
-            int q = col - qOffset;
-            int r = row;
-            HexCoord coord{q, r};
+            // (the q offset per row keeps the staggered layout rectangular)
+            HexCoord coord = HexOffset::ToAxial(col, row);
 
             // Apply Perlin noise filter if enabled
             if (noise.has_value())
@@ -60,31 +56,67 @@ void HexGrid::GenerateRectangularGrid()
             }
 
             _coords.push_back(coord);
-            _validCoords.insert(coord);
+            const size_t cell = static_cast<size_t>(row) * _config.width + col;
+            _validBits[cell / 64] |= uint64_t{1} << (cell % 64);
         }
     }
-}
 
-bool HexGrid::IsValid(const HexCoord& coord) const
-{
-    return _validCoords.find(coord) != _validCoords.end();
+    BuildNeighborTable();
 }
 
-std::vector<HexCoord> HexGrid::GetNeighbors(const HexCoord& coord) const
+void HexGrid::BuildNeighborTable()
 {
-    std::vector<HexCoord> neighbors;
-    neighbors.reserve(6);
+    ZoneScoped;
+    const size_t cellCount = static_cast<size_t>(std::max(0, _config.width)) * std::max(0, _config.height);
+    _neighborTable.assign(cellCount * 6, HexCoord{});
+    _neighborCounts.assign(cellCount, 0);
 
-    for (int i = 0; i < 6; i++)
+    for (const auto& coord : _coords)
     {
-        HexCoord neighbor = coord.Neighbor(i);
-        if (IsValid(neighbor))
+        const int cell = CellIndex(coord);
+        HexCoord* slots = &_neighborTable[static_cast<size_t>(cell) * 6];
+        uint8_t count = 0;
+
+        for (int i = 0; i < 6; i++)
         {
-            neighbors.push_back(neighbor);
+            HexCoord neighbor = coord.Neighbor(i);
+            if (IsValid(neighbor))
+            {
+                slots[count++] = neighbor;
+            }
         }
+
+        _neighborCounts[cell] = count;
+    }
+}
+
+int HexGrid::CellIndex(const HexCoord& coord) const
+{
+    const int row = HexOffset::Row(coord);
+    const int col = HexOffset::Column(coord);
+    if (row < 0 || row >= _config.height || col < 0 || col >= _config.width)
+    {
+        return -1;
+    }
+    return row * _config.width + col;
+}
+
+bool HexGrid::IsValid(const HexCoord& coord) const
+{
+    const int cell = CellIndex(coord);
+    if (cell < 0) return false;
+    return (_validBits[cell / 64] >> (cell % 64)) & 1;
+}
+
+std::span<const HexCoord> HexGrid::GetNeighbors(const HexCoord& coord) const
+{
+    if (!IsValid(coord))
+    {
+        return {};
     }
 
-    return neighbors;
+    const int cell = CellIndex(coord);
+    return {&_neighborTable[static_cast<size_t>(cell) * 6], _neighborCounts[cell]};
 }
 
 Vector2 HexGrid::HexToWorld(const HexCoord& coord) const
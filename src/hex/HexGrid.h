@@ -6,8 +6,9 @@
 #define ATLAS_HEXGRID_H
 
 #include "HexCoord.h"
+#include <cstdint>
+#include <span>
 #include <vector>
-#include <unordered_set>
 
 struct HexGridConfig {
     int width = 32;  // Grid width in hexes (columns)
@@ -30,8 +31,9 @@ public:
     // Check if coordinate is within the grid
     [[nodiscard]] bool IsValid(const HexCoord &coord) const;
 
-    // Get all valid neighbors of a coordinate
-    [[nodiscard]] std::vector<HexCoord> GetNeighbors(const HexCoord &coord) const;
+    // Get all valid neighbors of a grid coordinate (precomputed, no allocation;
+    // empty for coordinates outside the grid)
+    [[nodiscard]] std::span<const HexCoord> GetNeighbors(const HexCoord &coord) const;
 
     // Get all coordinates in the grid
     [[nodiscard]] const std::vector<HexCoord> &GetAllCoords() const { return _coords; }
@@ -60,9 +62,17 @@ public:
 private:
     HexGridConfig _config;
     std::vector<HexCoord> _coords;
-    std::unordered_set<HexCoord, HexCoordHash> _validCoords;
+
+    // Per offset-grid cell (see HexOffset): validity bit and up to 6 valid neighbors
+    std::vector<uint64_t> _validBits;
+    std::vector<HexCoord> _neighborTable; // 6 slots per cell
+    std::vector<uint8_t> _neighborCounts;
+
+    // Offset-grid cell index of a coordinate, or -1 if outside the rectangle
+    [[nodiscard]] int CellIndex(const HexCoord &coord) const;
 
     void GenerateRectangularGrid();
+    void BuildNeighborTable();
 };
 
 #endif // ATLAS_HEXGRID_H
@@ -2,6 +2,7 @@
 //
 
 #include "HexMapData.h"
+#include <unordered_set>
 
 #include <tracy/Tracy.hpp>
 
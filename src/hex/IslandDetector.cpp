@@ -6,7 +6,7 @@
 #include <algorithm>
 #include <unordered_map>
 
-#include <tracy/Tracy.hpp>
+#include "../Profiling.h"
 
 std::vector<Island> IslandDetector::FindIslands(const GameState& state)
 {
@@ -46,7 +46,7 @@ void IslandDetector::DFSTerritory(
         island.totalHexCount += static_cast<int>(territory->hexes.size());
 
         // Visit all unvisited neighbors
-        for (TerritoryId neighborId : territory->neighbors)
+        for (TerritoryId neighborId : state.GetNeighbors(current))
         {
             if (visited.find(neighborId) == visited.end())
             {
@@ -97,7 +97,7 @@ std::vector<TerritoryId> IslandDetector::KeepLargestIslandOnly(GameState& state)
             {
                 for (const auto& hex : territory->hexes)
                 {
-                    state.hexToTerritory.erase(hex);
+                    state.hexToTerritory.Erase(hex);
                 }
             }
             removed.push_back(tid);
@@ -107,6 +107,7 @@ std::vector<TerritoryId> IslandDetector::KeepLargestIslandOnly(GameState& state)
     // Rebuild territories vector with only kept territories and remap IDs
     std::vector<TerritoryData> keptTerritories;
     std::unordered_map<TerritoryId, TerritoryId> idRemap; // old -> new
+    std::vector<TerritoryId> keptOldIds;                  // new -> old
 
     TerritoryId newId = 0;
     for (auto& territory : state.territories)
@@ -114,29 +115,34 @@ std::vector<TerritoryId> IslandDetector::KeepLargestIslandOnly(GameState& state)
         if (keepSet.find(territory.id) != keepSet.end())
         {
             idRemap[territory.id] = newId;
+            keptOldIds.push_back(territory.id);
             territory.id = newId;
             keptTerritories.push_back(std::move(territory));
             newId++;
         }
     }
 
-    // Update neighbor references with new IDs
-    for (auto& territory : keptTerritories)
+    // Rebuild the adjacency graph with new IDs (kept territories preserve their
+    // relative order, so each remapped neighbor row stays sorted)
+    TerritoryGraph newGraph;
+    newGraph.offsets.reserve(keptTerritories.size() + 1);
+    newGraph.offsets.push_back(0);
+    for (TerritoryId oldId : keptOldIds)
     {
-        std::vector<TerritoryId> newNeighbors;
-        for (TerritoryId neighborId : territory.neighbors)
+        for (TerritoryId neighborId : state.GetNeighbors(oldId))
         {
             auto it = idRemap.find(neighborId);
             if (it != idRemap.end())
             {
-                newNeighbors.push_back(it->second);
+                newGraph.neighbors.push_back(it->second);
             }
         }
-        territory.neighbors = std::move(newNeighbors);
+        newGraph.offsets.push_back(static_cast<uint32_t>(newGraph.neighbors.size()));
     }
+    state.adjacency = std::move(newGraph);
 
     // Update hexToTerritory with new IDs
-    for (auto& [coord, oldId] : state.hexToTerritory)
+    for (TerritoryId& oldId : state.hexToTerritory.cells)
     {
         auto it = idRemap.find(oldId);
         if (it != idRemap.end())
@@ -8,19 +8,11 @@
 #include <algorithm>
 #include <unordered_set>
 
-#include <tracy/Tracy.hpp>
+#include "../Profiling.h"
 
 TerritoryGenerator::TerritoryGenerator(unsigned int seed)
+    : _rng(MakeRandomEngine(seed))
 {
-    if (seed == 0)
-    {
-        std::random_device rd;
-        _rng = std::mt19937(rd());
-    }
-    else
-    {
-        _rng = std::mt19937(seed);
-    }
 }
 
 void TerritoryGenerator::Generate(const HexGrid& grid, GameState& state)
@@ -28,7 +20,7 @@ void TerritoryGenerator::Generate(const HexGrid& grid, GameState& state)
     ZoneScoped;
     // Clear existing data
     state.territories.clear();
-    state.hexToTerritory.clear();
+    state.hexToTerritory.Reset(grid.GetWidth(), grid.GetHeight());
 
     // Select seed points
     std::vector<HexCoord> seeds = SelectSeedPoints(grid, state.config.targetTerritoryCount);
@@ -58,6 +50,8 @@ void TerritoryGenerator::Generate(const HexGrid& grid, GameState& state)
     {
         territory.centerHex = FindTerritoryCenter(territory);
     }
+
+    state.RebuildTerritoryArrays();
 }
 
 std::vector<HexCoord> TerritoryGenerator::SelectSeedPoints(
@@ -157,7 +151,7 @@ void TerritoryGenerator::FloodFillTerritories(
         // Assign to territory
         assigned.insert(coord);
         state.territories[territoryId].hexes.push_back(coord);
-        state.hexToTerritory[coord] = territoryId;
+        state.hexToTerritory.Set(coord, territoryId);
 
         // Add unassigned neighbors
         for (const auto& neighbor : grid.GetNeighbors(coord))
@@ -183,7 +177,7 @@ void TerritoryGenerator::FillHoles(
     std::unordered_set<HexCoord, HexCoordHash> unassigned;
     for (const auto& coord : grid.GetAllCoords())
     {
-        if (state.hexToTerritory.find(coord) == state.hexToTerritory.end())
+        if (!state.hexToTerritory.Contains(coord))
         {
             unassigned.insert(coord);
         }
@@ -257,7 +251,7 @@ void TerritoryGenerator::FillHoles(
         for (const auto& coord : hole)
         {
             state.territories[newOwner].hexes.push_back(coord);
-            state.hexToTerritory[coord] = newOwner;
+            state.hexToTerritory.Set(coord, newOwner);
         }
     }
 }
@@ -267,10 +261,16 @@ void TerritoryGenerator::CalculateTerritoryNeighbors(
     GameState& state)
 {
     ZoneScoped;
-    // For each territory, find adjacent territories
-    for (auto& territory : state.territories)
+    TerritoryGraph& graph = state.adjacency;
+    graph.Clear();
+    graph.offsets.reserve(state.territories.size() + 1);
+    graph.offsets.push_back(0);
+
+    // For each territory, find adjacent territories and append them as one CSR row
+    std::vector<TerritoryId> row;
+    for (const auto& territory : state.territories)
     {
-        std::unordered_set<TerritoryId> neighborSet;
+        row.clear();
 
         for (const auto& hex : territory.hexes)
         {
@@ -280,12 +280,16 @@ void TerritoryGenerator::CalculateTerritoryNeighbors(
                 if (neighborTerritory != TERRITORY_NONE &&
                     neighborTerritory != territory.id)
                 {
-                    neighborSet.insert(neighborTerritory);
+                    row.push_back(neighborTerritory);
                 }
             }
         }
 
-        territory.neighbors.assign(neighborSet.begin(), neighborSet.end());
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+
+        graph.neighbors.insert(graph.neighbors.end(), row.begin(), row.end());
+        graph.offsets.push_back(static_cast<uint32_t>(graph.neighbors.size()));
     }
 }
 
@@ -339,7 +343,7 @@ void TerritoryGenerator::AssignToPlayers(GameState& state)
     for (size_t i = 0; i < territoryOrder.size(); i++)
     {
         PlayerId player = static_cast<PlayerId>(i % state.config.playerCount);
-        state.territories[territoryOrder[i]].owner = player;
+        state.SetTerritoryOwner(territoryOrder[i], player);
     }
 
     // Distribute starting dice to each player
@@ -347,9 +351,12 @@ void TerritoryGenerator::AssignToPlayers(GameState& state)
     {
         // Get all territories owned by this player
         std::vector<TerritoryId> playerTerritories;
-        for (const auto& t : state.territories)
+        for (size_t i = 0; i < state.territoryArrays.Size(); i++)
         {
-            if (t.owner == p) playerTerritories.push_back(t.id);
+            if (state.territoryArrays.owner[i] == p)
+            {
+                playerTerritories.push_back(static_cast<TerritoryId>(i));
+            }
         }
 
         if (playerTerritories.empty()) continue;
@@ -365,9 +372,10 @@ void TerritoryGenerator::AssignToPlayers(GameState& state)
             int idx = std::uniform_int_distribution<>(0, static_cast<int>(playerTerritories.size()) - 1)(_rng);
             TerritoryId tid = playerTerritories[idx];
 
-            if (state.territories[tid].diceCount < MAX_DICE_PER_TERRITORY)
+            uint8_t dice = state.territoryArrays.diceCount[tid];
+            if (dice < MAX_DICE_PER_TERRITORY)
             {
-                state.territories[tid].diceCount++;
+                state.SetTerritoryDice(tid, dice + 1);
                 diceToDistribute--;
             }
             else
@@ -7,7 +7,7 @@
 
 #include "HexGrid.h"
 #include "../game/GameData.h"
-#include <random>
+#include "../Random.h"
 
 class TerritoryGenerator
 {
@@ -21,7 +21,7 @@ public:
     void AssignToPlayers(GameState& state);
 
 private:
-    std::mt19937 _rng;
+    RandomEngine _rng;
 
     // Select evenly-distributed seed points for territories
     std::vector<HexCoord> SelectSeedPoints(
@@ -5,7 +5,7 @@
 #ifndef ATLAS_MATH_H
 #define ATLAS_MATH_H
 
-#include <SDL3/SDL_stdinc.h>
+#include <cmath>
 
 struct Vector2
 {
@@ -15,7 +15,7 @@ struct Vector2
     {
         const float dx = v2.x - v1.x;
         const float dy = v2.y - v1.y;
-        return SDL_sqrtf(dx * dx + dy * dy);
+        return std::sqrt(dx * dx + dy * dy);
     }
 
     [[nodiscard]] static float Dot(const Vector2& v1, const Vector2& v2)
@@ -36,7 +36,7 @@ struct Vector2
 
     [[nodiscard]] float Magnitude() const
     {
-        return SDL_sqrtf(MagnitudeSquared());
+        return std::sqrt(MagnitudeSquared());
     }
 
     [[nodiscard]] float DistanceBetween(const Vector2& v2) const { return DistanceBetween(*this, v2); }
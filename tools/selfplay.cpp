@@ -0,0 +1,197 @@
+//
+// selfplay.cpp - Headless AI-vs-AI tournament runner
+//
+// Plays N complete games with every seat driven by AIController, spread across
+// all cores, and prints throughput and per-seat win rates as JSON.
+//
+// Usage: hexempire_selfplay [-n games] [-j threads] [-s seed] [-p players] [-t maxTurns]
+//                           [-m mctsMillis] [-r mctsPlayouts] [-b]
+//
+// With -m or -r, seat 0 is played by MCTSController (single-threaded, mctsMillis
+// or mctsPlayouts per decision; a playout budget keeps runs reproducible); with
+// -b, seat 0 uses the turn planner. Other seats stay greedy.
+//
+
+#include "../src/game/GameData.h"
+#include "../src/game/GameController.h"
+#include "../src/game/AIController.h"
+#include "../src/game/MCTSController.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct SelfPlayArgs {
+    int gameCount = 100;
+    int threadCount = 0; // 0 = one per hardware thread
+    unsigned int seed = 1;
+    int playerCount = 8;
+    int maxTurns = 1000; // Games still running after this many turns count as draws
+    int mctsMillis = 0;  // 0 = no time budget
+    int mctsPlayouts = 0; // 0 = no playout budget; both 0 = every seat greedy
+    bool planner = false; // Seat 0 plans whole turns
+};
+
+struct SelfPlayTotals {
+    int games = 0;
+    int draws = 0;
+    long long turns = 0;
+    std::array<int, MAX_PLAYERS> seatWins{};
+};
+
+SelfPlayArgs ParseArgs(int argc, char **argv) {
+    SelfPlayArgs args;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            args.gameCount = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            args.threadCount = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            args.seed = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            args.playerCount = std::clamp(std::stoi(argv[++i]), 2, MAX_PLAYERS);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            args.maxTurns = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            args.mctsMillis = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            args.mctsPlayouts = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "-b") == 0) {
+            args.planner = true;
+        }
+    }
+
+    if (args.threadCount <= 0) {
+        args.threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    return args;
+}
+
+// Same map setup as a normal game in main.cpp, with no human seat
+GameConfig MakeGameConfig(const SelfPlayArgs &args, int gameIndex) {
+    GameConfig config;
+    config.gridWidth = 100;
+    config.gridHeight = 56;
+    config.playerCount = args.playerCount;
+    config.humanPlayerIndex = -1;
+    config.targetTerritoryCount = 120;
+    config.startingDicePerPlayer = 30;
+    config.hexSize = 24.0f;
+    config.fillHoles = false;
+    config.keepLargestIslandOnly = true;
+
+    // Seed 0 means "random" to the core, so skip it to keep runs reproducible
+    config.seed = args.seed + static_cast<unsigned int>(gameIndex) * 7919u;
+    if (config.seed == 0) config.seed = 1;
+
+    return config;
+}
+
+void RunWorker(const SelfPlayArgs &args, std::atomic<int> &nextGame,
+               SelfPlayTotals &totals, std::mutex &totalsMutex) {
+    GameController controller;
+    SelfPlayTotals local;
+
+    for (int gameIndex = nextGame++; gameIndex < args.gameCount; gameIndex = nextGame++) {
+        GameConfig config = MakeGameConfig(args, gameIndex);
+        controller.InitializeGame(config);
+
+        std::unique_ptr<AIController> ai;
+        if (args.mctsMillis > 0 || args.mctsPlayouts > 0) {
+            MCTSConfig mcts;
+            mcts.timeBudgetMs = args.mctsMillis;
+            mcts.playoutBudget = args.mctsPlayouts;
+            mcts.threadCount = 1; // Games already run in parallel
+            mcts.searchPlayers = 1u << 0;
+            ai = std::make_unique<MCTSController>(&controller, mcts, config.seed);
+        } else {
+            ai = std::make_unique<AIController>(&controller, config.seed);
+        }
+        if (args.planner) {
+            TurnPlannerConfig planner;
+            planner.plannerPlayers = 1u << 0;
+            ai->EnableTurnPlanner(planner);
+        }
+        controller.SetAIController(ai.get());
+
+        controller.RunUntil(args.maxTurns + 1);
+
+        const GameState &state = controller.GetState();
+        local.games++;
+        local.turns += state.turnNumber;
+        if (state.IsGameOver() && state.winner < MAX_PLAYERS) {
+            local.seatWins[state.winner]++;
+        } else {
+            local.draws++;
+        }
+
+        controller.SetAIController(nullptr);
+    }
+
+    std::lock_guard<std::mutex> lock(totalsMutex);
+    totals.games += local.games;
+    totals.draws += local.draws;
+    totals.turns += local.turns;
+    for (int p = 0; p < MAX_PLAYERS; p++) {
+        totals.seatWins[p] += local.seatWins[p];
+    }
+}
+
+void PrintReport(const SelfPlayArgs &args, const SelfPlayTotals &totals, double seconds) {
+    double games = std::max(1, totals.games);
+
+    std::printf("{\n");
+    std::printf("  \"games\": %d,\n", totals.games);
+    std::printf("  \"threads\": %d,\n", args.threadCount);
+    std::printf("  \"players\": %d,\n", args.playerCount);
+    std::printf("  \"seed\": %u,\n", args.seed);
+    std::printf("  \"mctsMillis\": %d,\n", args.mctsMillis);
+    std::printf("  \"mctsPlayouts\": %d,\n", args.mctsPlayouts);
+    std::printf("  \"planner\": %s,\n", args.planner ? "true" : "false");
+    std::printf("  \"elapsedSeconds\": %.3f,\n", seconds);
+    std::printf("  \"gamesPerSec\": %.3f,\n", totals.games / seconds);
+    std::printf("  \"turnsPerSec\": %.3f,\n", totals.turns / seconds);
+    std::printf("  \"averageGameLength\": %.2f,\n", totals.turns / games);
+    std::printf("  \"draws\": %d,\n", totals.draws);
+    std::printf("  \"seatWinRates\": [");
+    for (int p = 0; p < args.playerCount; p++) {
+        std::printf("%s%.4f", p ? ", " : "", totals.seatWins[p] / games);
+    }
+    std::printf("]\n");
+    std::printf("}\n");
+}
+
+int main(int argc, char **argv) {
+    SelfPlayArgs args = ParseArgs(argc, argv);
+
+    SelfPlayTotals totals;
+    std::mutex totalsMutex;
+    std::atomic<int> nextGame{0};
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    workers.reserve(args.threadCount);
+    for (int i = 0; i < args.threadCount; i++) {
+        workers.emplace_back(RunWorker, std::cref(args), std::ref(nextGame),
+                             std::ref(totals), std::ref(totalsMutex));
+    }
+    for (auto &worker: workers) {
+        worker.join();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    PrintReport(args, totals, std::max(elapsed.count(), 1e-9));
+
+    return 0;
+}